@@ -0,0 +1,370 @@
+#include <benchmark/benchmark.h>
+#include <deque>
+#include <memory>
+#include <queue>
+#include <thread>
+#include "pmr_queue.h"
+#include "pmr_mpmc_queue.h"
+#include "pmr_work_stealing_deque.h"
+#include "pmr_huge_page_resource.h"
+#include "pmr_queue_policy.h"
+
+class CountingResource : public std::pmr::memory_resource {
+private:
+    std::pmr::memory_resource* upstream_;
+
+public:
+    std::size_t bytes_allocated = 0;
+    
+    explicit CountingResource(std::pmr::memory_resource* upstream = 
+                             std::pmr::new_delete_resource())
+        : upstream_(upstream) {}
+
+protected:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        bytes_allocated += bytes;
+        return upstream_->allocate(bytes, alignment);
+    }
+    
+    void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override {
+        upstream_->deallocate(ptr, bytes, alignment);
+    }
+    
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+template<typename T>
+class PmrDequeQueue {
+private:
+    std::pmr::deque<T> items_;
+
+public:
+    explicit PmrDequeQueue(std::pmr::memory_resource* mr) : items_(mr) {}
+    
+    void push(const T& value) { items_.push_back(value); }
+    void pop() { items_.pop_front(); }
+    T& front() { return items_.front(); }
+    void clear() { items_.clear(); }
+    auto begin() { return items_.begin(); }
+    auto end() { return items_.end(); }
+};
+
+template<typename T>
+class StdQueue {
+private:
+    std::queue<T> items_;
+
+public:
+    explicit StdQueue(std::pmr::memory_resource*) {}
+    
+    void push(const T& value) { items_.push(value); }
+    void pop() { items_.pop(); }
+    T& front() { return items_.front(); }
+    void clear() { items_ = std::queue<T>(); }
+};
+
+struct DynamicIndexed {
+    CountingResource upstream;
+    DynamicMemoryResource mr{&upstream};
+    PmrQueue<int> queue{&mr};
+};
+
+struct DynamicInline {
+    CountingResource upstream;
+    DynamicMemoryResource mr{{.tracking = BlockTracking::inline_header}, &upstream};
+    PmrQueue<int> queue{&mr};
+};
+
+struct DynamicNodeCache {
+    CountingResource upstream;
+    DynamicMemoryResource mr{&upstream};
+    PmrQueue<int> queue{PmrQueueOptions{.node_cache_limit = 16384}, &mr};
+};
+
+struct NodePool {
+    CountingResource upstream;
+    QueueNodePoolResource<int> mr{4096, &upstream};
+    PmrQueue<int> queue{&mr};
+};
+
+struct HugePagePool {
+    HugePageResource huge;
+    CountingResource upstream{&huge};
+    QueueNodePoolResource<int> mr{4096, &upstream};
+    PmrQueue<int> queue{&mr};
+};
+
+struct Chunked {
+    CountingResource upstream;
+    ChunkedPmrQueue<int, 256> queue{&upstream};
+};
+
+struct PolicyStatic {
+    CountingResource upstream;
+    ConfiguredQueue<int, QueuePolicy<NodeStorage, SingleThreaded, 
+                                     StaticAllocation<std::allocator<int>>>> queue;
+};
+
+struct PolicyChunkedPmr {
+    CountingResource upstream;
+    ConfiguredQueue<int, QueuePolicy<ChunkedStorage<256>>> queue{&upstream};
+};
+
+struct StdPool {
+    CountingResource upstream;
+    std::pmr::unsynchronized_pool_resource mr{&upstream};
+    PmrQueue<int> queue{&mr};
+};
+
+struct StdPmrDeque {
+    CountingResource upstream;
+    PmrDequeQueue<int> queue{&upstream};
+};
+
+struct StdQueueBaseline {
+    CountingResource upstream;
+    StdQueue<int> queue{&upstream};
+};
+
+template<typename Setup>
+static void fill(Setup& setup, std::int64_t count) {
+    for (std::int64_t i = 0; i < count; ++i) {
+        setup.queue.push(static_cast<int>(i));
+    }
+}
+
+template<typename Setup>
+static void report(benchmark::State& state, const Setup& setup, std::size_t bytes_before) {
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["bytes_allocated"] = benchmark::Counter(
+        static_cast<double>(setup.upstream.bytes_allocated - bytes_before),
+        benchmark::Counter::kAvgIterations);
+}
+
+template<typename Setup>
+static void BM_Push(benchmark::State& state) {
+    std::size_t bytes = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto setup = std::make_unique<Setup>();
+        state.ResumeTiming();
+        
+        fill(*setup, state.range(0));
+        
+        state.PauseTiming();
+        bytes = setup->upstream.bytes_allocated;
+        setup.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["bytes_allocated"] = static_cast<double>(bytes);
+}
+
+template<typename Setup>
+static void BM_Pop(benchmark::State& state) {
+    auto setup = std::make_unique<Setup>();
+    for (auto _ : state) {
+        state.PauseTiming();
+        fill(*setup, state.range(0));
+        state.ResumeTiming();
+        
+        for (std::int64_t i = 0; i < state.range(0); ++i) {
+            benchmark::DoNotOptimize(setup->queue.front());
+            setup->queue.pop();
+        }
+    }
+    report(state, *setup, 0);
+}
+
+template<typename Setup>
+static void BM_PushPopSteady(benchmark::State& state) {
+    auto setup = std::make_unique<Setup>();
+    fill(*setup, state.range(0));
+    const std::size_t bytes_before = setup->upstream.bytes_allocated;
+    
+    for (auto _ : state) {
+        for (std::int64_t i = 0; i < state.range(0); ++i) {
+            setup->queue.push(static_cast<int>(i));
+            benchmark::DoNotOptimize(setup->queue.front());
+            setup->queue.pop();
+        }
+    }
+    report(state, *setup, bytes_before);
+}
+
+template<typename Setup>
+static void BM_Iterate(benchmark::State& state) {
+    auto setup = std::make_unique<Setup>();
+    fill(*setup, state.range(0));
+    const std::size_t bytes_before = setup->upstream.bytes_allocated;
+    
+    for (auto _ : state) {
+        long long sum = 0;
+        for (int value : setup->queue) {
+            sum += value;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    report(state, *setup, bytes_before);
+}
+
+template<typename Setup>
+static void BM_Clear(benchmark::State& state) {
+    auto setup = std::make_unique<Setup>();
+    for (auto _ : state) {
+        state.PauseTiming();
+        fill(*setup, state.range(0));
+        state.ResumeTiming();
+        
+        setup->queue.clear();
+    }
+    report(state, *setup, 0);
+}
+
+template<typename Policy>
+static void BM_ChunkedComplexClear(benchmark::State& state) {
+    std::pmr::unsynchronized_pool_resource pool;
+    ChunkedPmrQueue<ComplexType> queue(&pool);
+    const std::string name(64, 'x');
+    
+    for (auto _ : state) {
+        state.PauseTiming();
+        for (std::int64_t i = 0; i < state.range(0); ++i) {
+            queue.emplace(static_cast<int>(i), 0.5, name);
+        }
+        state.ResumeTiming();
+        
+        if constexpr (std::is_same_v<Policy, std::execution::sequenced_policy>) {
+            queue.clear();
+        } else {
+            queue.clear(Policy{});
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template<typename Resource>
+static void BM_AllocateDeallocate(benchmark::State& state) {
+    CountingResource upstream;
+    std::vector<void*> blocks(static_cast<std::size_t>(state.range(0)));
+    
+    for (auto _ : state) {
+        Resource mr(&upstream);
+        for (auto& block : blocks) {
+            block = mr.allocate(sizeof(QueueNode<int>), alignof(QueueNode<int>));
+        }
+        for (void* block : blocks) {
+            mr.deallocate(block, sizeof(QueueNode<int>), alignof(QueueNode<int>));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["bytes_allocated"] = static_cast<double>(upstream.bytes_allocated) / 
+                                        static_cast<double>(state.iterations());
+}
+
+struct InlineDynamicMemoryResource : DynamicMemoryResource {
+    explicit InlineDynamicMemoryResource(std::pmr::memory_resource* upstream)
+        : DynamicMemoryResource({.tracking = BlockTracking::inline_header}, upstream) {}
+};
+
+struct IntNodePoolResource : QueueNodePoolResource<int> {
+    explicit IntNodePoolResource(std::pmr::memory_resource* upstream)
+        : QueueNodePoolResource<int>(4096, upstream) {}
+};
+
+static std::pmr::synchronized_pool_resource mpmc_pool;
+static std::unique_ptr<MpmcPmrQueue<int>> mpmc_queue;
+
+static void BM_MpmcPushPop(benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        mpmc_queue = std::make_unique<MpmcPmrQueue<int>>(&mpmc_pool);
+    }
+    
+    for (auto _ : state) {
+        mpmc_queue->push(state.thread_index());
+        while (!mpmc_queue->try_pop()) {
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+    
+    if (state.thread_index() == 0) {
+        mpmc_queue.reset();
+    }
+}
+
+static std::pmr::synchronized_pool_resource deque_pool;
+static std::unique_ptr<WorkStealingDeque<int>> work_deque;
+
+static void BM_WorkStealing(benchmark::State& state) {
+    constexpr int batch = 256;
+    if (state.thread_index() == 0) {
+        work_deque = std::make_unique<WorkStealingDeque<int>>(batch, &deque_pool);
+    }
+    
+    std::int64_t executed = 0;
+    for (auto _ : state) {
+        if (state.thread_index() == 0) {
+            for (int i = 0; i < batch; ++i) {
+                work_deque->push(i);
+            }
+            while (auto task = work_deque->try_pop()) {
+                benchmark::DoNotOptimize(*task);
+                ++executed;
+            }
+        } else if (auto task = work_deque->try_steal()) {
+            benchmark::DoNotOptimize(*task);
+            ++executed;
+        }
+    }
+    state.SetItemsProcessed(executed);
+    
+    if (state.thread_index() == 0) {
+        work_deque.reset();
+    }
+}
+
+#define PMR_QUEUE_BENCHMARKS(setup)                                                  \
+    BENCHMARK_TEMPLATE(BM_Push, setup)->RangeMultiplier(10)->Range(1000, 10000000);  \
+    BENCHMARK_TEMPLATE(BM_Pop, setup)->RangeMultiplier(10)->Range(1000, 10000000);   \
+    BENCHMARK_TEMPLATE(BM_PushPopSteady, setup)->RangeMultiplier(10)->Range(1000, 10000000); \
+    BENCHMARK_TEMPLATE(BM_Clear, setup)->RangeMultiplier(10)->Range(1000, 10000000)
+
+PMR_QUEUE_BENCHMARKS(DynamicIndexed);
+PMR_QUEUE_BENCHMARKS(DynamicInline);
+PMR_QUEUE_BENCHMARKS(DynamicNodeCache);
+PMR_QUEUE_BENCHMARKS(NodePool);
+PMR_QUEUE_BENCHMARKS(HugePagePool);
+PMR_QUEUE_BENCHMARKS(Chunked);
+PMR_QUEUE_BENCHMARKS(PolicyStatic);
+PMR_QUEUE_BENCHMARKS(PolicyChunkedPmr);
+PMR_QUEUE_BENCHMARKS(StdPool);
+PMR_QUEUE_BENCHMARKS(StdPmrDeque);
+PMR_QUEUE_BENCHMARKS(StdQueueBaseline);
+
+BENCHMARK_TEMPLATE(BM_Iterate, DynamicIndexed)->RangeMultiplier(10)->Range(1000, 10000000);
+BENCHMARK_TEMPLATE(BM_Iterate, NodePool)->RangeMultiplier(10)->Range(1000, 10000000);
+BENCHMARK_TEMPLATE(BM_Iterate, Chunked)->RangeMultiplier(10)->Range(1000, 10000000);
+BENCHMARK_TEMPLATE(BM_Iterate, StdPool)->RangeMultiplier(10)->Range(1000, 10000000);
+BENCHMARK_TEMPLATE(BM_Iterate, StdPmrDeque)->RangeMultiplier(10)->Range(1000, 10000000);
+
+BENCHMARK_TEMPLATE(BM_AllocateDeallocate, DynamicMemoryResource)
+    ->RangeMultiplier(10)->Range(1000, 10000000);
+BENCHMARK_TEMPLATE(BM_AllocateDeallocate, InlineDynamicMemoryResource)
+    ->RangeMultiplier(10)->Range(1000, 10000000);
+BENCHMARK_TEMPLATE(BM_AllocateDeallocate, IntNodePoolResource)
+    ->RangeMultiplier(10)->Range(1000, 10000000);
+BENCHMARK_TEMPLATE(BM_AllocateDeallocate, std::pmr::unsynchronized_pool_resource)
+    ->RangeMultiplier(10)->Range(1000, 10000000);
+
+BENCHMARK_TEMPLATE(BM_ChunkedComplexClear, std::execution::sequenced_policy)
+    ->RangeMultiplier(10)->Range(1000, 1000000);
+BENCHMARK_TEMPLATE(BM_ChunkedComplexClear, std::execution::parallel_policy)
+    ->RangeMultiplier(10)->Range(1000, 1000000);
+
+BENCHMARK(BM_MpmcPushPop)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK(BM_WorkStealing)
+    ->ThreadRange(1, std::max(2u, std::thread::hardware_concurrency()))->UseRealTime();
+
+BENCHMARK_MAIN();
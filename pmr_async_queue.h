@@ -0,0 +1,314 @@
+#pragma once
+#include "pmr_queue.h"
+#include <coroutine>
+#include <cstring>
+#include <exception>
+#include <mutex>
+
+class AsyncExecutor {
+public:
+    virtual ~AsyncExecutor() = default;
+    virtual void schedule(std::coroutine_handle<> handle) = 0;
+};
+
+template<typename T>
+class AsyncPmrQueue;
+
+// Eagerly started coroutine whose frame is allocated from a memory resource: the one passed
+// after std::allocator_arg, else the resource of an AsyncPmrQueue passed first, else the default.
+// GCC 12 at -O0 reports a false -Wmismatched-new-delete on each PmrTask coroutine definition.
+class PmrTask {
+public:
+    struct promise_type {
+        std::exception_ptr exception;
+        
+        PmrTask get_return_object() {
+            return PmrTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        
+        std::suspend_never initial_suspend() noexcept { 
+            return {}; 
+        }
+        
+        std::suspend_always final_suspend() noexcept { 
+            return {}; 
+        }
+        
+        void return_void() {}
+        
+        void unhandled_exception() {
+            exception = std::current_exception();
+        }
+        
+        template<typename... Args>
+        static void* operator new(std::size_t size, std::allocator_arg_t, 
+                                  const std::pmr::polymorphic_allocator<>& allocator, Args&...) {
+            return allocate_frame(size, allocator.resource());
+        }
+        
+        template<typename U, typename... Args>
+        static void* operator new(std::size_t size, AsyncPmrQueue<U>& queue, Args&...) {
+            return allocate_frame(size, queue.get_resource());
+        }
+        
+        template<typename... Args>
+        static void* operator new(std::size_t size, Args&...) {
+            return allocate_frame(size, std::pmr::get_default_resource());
+        }
+        
+        static void operator delete(void* frame, std::size_t size) {
+            const std::size_t offset = resource_offset(size);
+            std::pmr::memory_resource* resource;
+            std::memcpy(&resource, static_cast<std::byte*>(frame) + offset, sizeof(resource));
+            resource->deallocate(frame, offset + sizeof(resource), alignof(std::max_align_t));
+        }
+    
+    private:
+        static std::size_t resource_offset(std::size_t size) {
+            return (size + alignof(std::pmr::memory_resource*) - 1) & 
+                   ~(alignof(std::pmr::memory_resource*) - 1);
+        }
+        
+        // The owning resource is stored just past the frame so operator delete can find it.
+        static void* allocate_frame(std::size_t size, std::pmr::memory_resource* resource) {
+            const std::size_t offset = resource_offset(size);
+            void* frame = resource->allocate(offset + sizeof(resource), alignof(std::max_align_t));
+            std::memcpy(static_cast<std::byte*>(frame) + offset, &resource, sizeof(resource));
+            return frame;
+        }
+    };
+
+private:
+    std::coroutine_handle<promise_type> handle_;
+    
+    explicit PmrTask(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+
+public:
+    PmrTask(PmrTask&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+    
+    PmrTask& operator=(PmrTask&& other) noexcept {
+        if (this != &other) {
+            if (handle_) {
+                handle_.destroy();
+            }
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+        return *this;
+    }
+    
+    ~PmrTask() {
+        if (handle_) {
+            handle_.destroy();
+        }
+    }
+    
+    bool done() const {
+        return handle_ && handle_.done();
+    }
+    
+    void get() const {
+        if (handle_ && handle_.promise().exception) {
+            std::rethrow_exception(handle_.promise().exception);
+        }
+    }
+};
+
+// A thread-safe bounded queue for coroutines. Awaiting pop() suspends while it is empty and
+// awaiting push() suspends while it is full; woken coroutines are resumed on the thread that
+// woke them, or handed to the executor if one was given. Waiter lists use the same resource.
+template<typename T>
+class AsyncPmrQueue {
+public:
+    class PopAwaiter {
+    private:
+        friend class AsyncPmrQueue;
+        
+        AsyncPmrQueue& queue_;
+        std::optional<T> value_;
+        std::coroutine_handle<> handle_;
+    
+    public:
+        explicit PopAwaiter(AsyncPmrQueue& queue) : queue_(queue) {}
+        
+        bool await_ready() {
+            return queue_.try_take(value_);
+        }
+        
+        bool await_suspend(std::coroutine_handle<> handle) {
+            handle_ = handle;
+            return queue_.suspend_pop(this);
+        }
+        
+        T await_resume() {
+            return std::move(*value_);
+        }
+    };
+    
+    class PushAwaiter {
+    private:
+        friend class AsyncPmrQueue;
+        
+        AsyncPmrQueue& queue_;
+        T value_;
+        std::coroutine_handle<> handle_;
+    
+    public:
+        template<typename U>
+        PushAwaiter(AsyncPmrQueue& queue, U&& value) 
+            : queue_(queue), value_(std::forward<U>(value)) {}
+        
+        bool await_ready() {
+            return queue_.try_give(value_);
+        }
+        
+        bool await_suspend(std::coroutine_handle<> handle) {
+            handle_ = handle;
+            return queue_.suspend_push(this);
+        }
+        
+        void await_resume() const noexcept {}
+    };
+
+private:
+    mutable std::mutex mutex_;
+    PmrQueue<T> items_;
+    PmrQueue<PopAwaiter*> pop_waiters_;
+    PmrQueue<PushAwaiter*> push_waiters_;
+    std::size_t capacity_;
+    AsyncExecutor* executor_;
+
+public:
+    explicit AsyncPmrQueue(std::size_t capacity = std::numeric_limits<std::size_t>::max(),
+                          std::pmr::memory_resource* mr = std::pmr::get_default_resource(),
+                          AsyncExecutor* executor = nullptr)
+        : items_(mr), pop_waiters_(mr), push_waiters_(mr), 
+          capacity_(std::max<std::size_t>(capacity, 1)), executor_(executor) {}
+    
+    AsyncPmrQueue(const AsyncPmrQueue&) = delete;
+    AsyncPmrQueue& operator=(const AsyncPmrQueue&) = delete;
+    
+    [[nodiscard]] PopAwaiter pop() {
+        return PopAwaiter(*this);
+    }
+    
+    template<typename U>
+    [[nodiscard]] PushAwaiter push(U&& value) {
+        return PushAwaiter(*this, std::forward<U>(value));
+    }
+    
+    template<typename U>
+    [[nodiscard]] bool try_push(U&& value) {
+        T item(std::forward<U>(value));
+        return try_give(item);
+    }
+    
+    std::optional<T> try_pop() {
+        std::optional<T> result;
+        (void)try_take(result);
+        return result;
+    }
+    
+    std::size_t size() const {
+        std::lock_guard lock(mutex_);
+        return items_.size();
+    }
+    
+    bool empty() const {
+        std::lock_guard lock(mutex_);
+        return items_.empty();
+    }
+    
+    std::size_t capacity() const { 
+        return capacity_; 
+    }
+    
+    std::pmr::memory_resource* get_resource() const {
+        return items_.get_resource();
+    }
+
+private:
+    bool try_take(std::optional<T>& out) {
+        std::coroutine_handle<> woken;
+        {
+            std::lock_guard lock(mutex_);
+            if (items_.empty()) return false;
+            
+            out.emplace(items_.pop_value());
+            woken = admit_pusher();
+        }
+        resume(woken);
+        return true;
+    }
+    
+    bool suspend_pop(PopAwaiter* waiter) {
+        std::coroutine_handle<> woken;
+        {
+            std::lock_guard lock(mutex_);
+            if (items_.empty()) {
+                pop_waiters_.push(waiter);
+                return true;
+            }
+            
+            waiter->value_.emplace(items_.pop_value());
+            woken = admit_pusher();
+        }
+        resume(woken);
+        return false;
+    }
+    
+    bool try_give(T& value) {
+        std::coroutine_handle<> woken;
+        {
+            std::lock_guard lock(mutex_);
+            if (!offer(value, woken)) return false;
+        }
+        resume(woken);
+        return true;
+    }
+    
+    bool suspend_push(PushAwaiter* waiter) {
+        std::coroutine_handle<> woken;
+        {
+            std::lock_guard lock(mutex_);
+            if (!offer(waiter->value_, woken)) {
+                push_waiters_.push(waiter);
+                return true;
+            }
+        }
+        resume(woken);
+        return false;
+    }
+    
+    // Hands the value straight to a suspended consumer when there is one.
+    bool offer(T& value, std::coroutine_handle<>& woken) {
+        if (!pop_waiters_.empty()) {
+            PopAwaiter* waiter = pop_waiters_.pop_value();
+            waiter->value_.emplace(std::move(value));
+            woken = waiter->handle_;
+            return true;
+        }
+        if (items_.size() < capacity_) {
+            items_.push(std::move(value));
+            return true;
+        }
+        return false;
+    }
+    
+    std::coroutine_handle<> admit_pusher() {
+        if (push_waiters_.empty()) return {};
+        
+        PushAwaiter* waiter = push_waiters_.pop_value();
+        items_.push(std::move(waiter->value_));
+        return waiter->handle_;
+    }
+    
+    void resume(std::coroutine_handle<> handle) {
+        if (!handle) return;
+        
+        if (executor_) {
+            executor_->schedule(handle);
+        } else {
+            handle.resume();
+        }
+    }
+};
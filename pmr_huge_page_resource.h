@@ -0,0 +1,111 @@
+#pragma once
+#include "pmr_mapped_resource.h"
+#include <atomic>
+#include <linux/mman.h>
+
+enum class HugePageSize {
+    size_2mb,
+    size_1gb
+};
+
+enum class PageBacking {
+    explicit_huge_pages,
+    transparent_huge_pages,
+    normal_pages
+};
+
+struct HugePageOptions {
+    HugePageSize page_size = HugePageSize::size_2mb;
+    std::size_t chunk_size = 0;
+    bool allow_transparent = true;
+};
+
+// Tries MAP_HUGETLB first, then a huge-page aligned mapping advised with MADV_HUGEPAGE,
+// and finally plain pages, so it works on hosts with no huge pages reserved.
+class HugePageResource : public MappedChunkResource {
+private:
+    HugePageOptions options_;
+    std::atomic<PageBacking> backing_;
+
+public:
+    explicit HugePageResource(const HugePageOptions& options = {})
+        : MappedChunkResource(options.chunk_size ? options.chunk_size : huge_page_bytes(options.page_size)),
+          options_(options), backing_(PageBacking::explicit_huge_pages) {}
+    
+    static constexpr std::size_t huge_page_bytes(HugePageSize size) {
+        return size == HugePageSize::size_1gb ? std::size_t{1} << 30 : std::size_t{1} << 21;
+    }
+    
+    std::size_t huge_page_size() const { 
+        return huge_page_bytes(options_.page_size); 
+    }
+    
+    // The weakest backing any chunk has fallen back to so far.
+    PageBacking backing() const {
+        return backing_.load(std::memory_order_relaxed);
+    }
+
+protected:
+    std::size_t chunk_granularity() const override {
+        return huge_page_size();
+    }
+    
+    void* map_chunk(std::size_t size) override {
+        const int huge_flag = options_.page_size == HugePageSize::size_1gb ? MAP_HUGE_1GB : MAP_HUGE_2MB;
+        void* memory = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, 
+                              MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | huge_flag, -1, 0);
+        if (memory != MAP_FAILED) {
+            return memory;
+        }
+        
+        if (options_.allow_transparent) {
+            if (void* aligned = map_transparent(size)) {
+                degrade(PageBacking::transparent_huge_pages);
+                return aligned;
+            }
+        }
+        
+        memory = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (memory == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        degrade(PageBacking::normal_pages);
+        return memory;
+    }
+
+private:
+    void degrade(PageBacking backing) {
+        PageBacking current = backing_.load(std::memory_order_relaxed);
+        while (current < backing && 
+               !backing_.compare_exchange_weak(current, backing, std::memory_order_relaxed)) {
+        }
+    }
+    
+    // Over-maps by one huge page and trims, so khugepaged can back the range with whole pages.
+    void* map_transparent(std::size_t size) {
+        const std::size_t alignment = huge_page_size();
+        void* raw = ::mmap(nullptr, size + alignment, PROT_READ | PROT_WRITE, 
+                           MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw == MAP_FAILED) {
+            return nullptr;
+        }
+        
+        std::byte* start = static_cast<std::byte*>(raw);
+        std::byte* aligned = reinterpret_cast<std::byte*>(
+            (reinterpret_cast<std::uintptr_t>(start) + alignment - 1) & ~(alignment - 1));
+        if (aligned > start) {
+            ::munmap(start, static_cast<std::size_t>(aligned - start));
+        }
+        std::byte* end = aligned + size;
+        std::byte* raw_end = start + size + alignment;
+        if (raw_end > end) {
+            ::munmap(end, static_cast<std::size_t>(raw_end - end));
+        }
+        
+        if (::madvise(aligned, size, MADV_HUGEPAGE) != 0) {
+            ::munmap(aligned, size);
+            return nullptr;
+        }
+        return aligned;
+    }
+};
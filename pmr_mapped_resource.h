@@ -0,0 +1,156 @@
+#pragma once
+#include "pmr_queue.h"
+#include <sys/mman.h>
+#include <unistd.h>
+
+// Carves blocks out of mmap'd chunks; freed blocks are kept per size class, and blocks
+// aligned beyond a page are only reused for requests they satisfy.
+// Derived resources decide how each chunk is mapped (node binding, huge pages, ...).
+class MappedChunkResource : public std::pmr::memory_resource {
+public:
+    static constexpr std::size_t min_block_size = 16;
+    static constexpr std::size_t size_classes = 40;
+
+private:
+    struct Chunk {
+        Chunk* next;
+        std::size_t size;
+    };
+    
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+    
+    // Blocks aligned beyond a page keep their class in the block so reuse can match both.
+    struct OverAlignedBlock {
+        OverAlignedBlock* next;
+        std::size_t size_class;
+    };
+    
+    std::size_t chunk_size_;
+    Chunk* chunks_;
+    std::byte* cursor_;
+    std::byte* limit_;
+    std::array<FreeBlock*, size_classes> free_lists_;
+    OverAlignedBlock* over_aligned_;
+    std::size_t mapped_bytes_;
+    mutable std::mutex mutex_;
+
+public:
+    explicit MappedChunkResource(std::size_t chunk_size)
+        : chunk_size_(chunk_size), chunks_(nullptr), cursor_(nullptr), limit_(nullptr), 
+          free_lists_{}, over_aligned_(nullptr), mapped_bytes_(0) {}
+    
+    ~MappedChunkResource() override {
+        while (chunks_) {
+            Chunk* chunk = chunks_;
+            chunks_ = chunk->next;
+            ::munmap(chunk, chunk->size);
+        }
+    }
+    
+    MappedChunkResource(const MappedChunkResource&) = delete;
+    MappedChunkResource& operator=(const MappedChunkResource&) = delete;
+    
+    std::size_t mapped_bytes() const {
+        std::lock_guard lock(mutex_);
+        return mapped_bytes_;
+    }
+    
+    static std::size_t page_size() {
+        static const std::size_t size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+        return size;
+    }
+
+protected:
+    // Called with the resource locked; size is already a multiple of chunk_granularity().
+    virtual void* map_chunk(std::size_t size) = 0;
+    
+    virtual std::size_t chunk_granularity() const {
+        return page_size();
+    }
+    
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        const std::size_t size_class = class_of(std::max({bytes, alignment, min_block_size}));
+        const std::size_t block_size = std::size_t{1} << size_class;
+        const std::size_t block_alignment = std::max(std::min(block_size, page_size()), alignment);
+        
+        std::lock_guard lock(mutex_);
+        if (alignment > page_size()) {
+            if (void* block = reuse_over_aligned(size_class, alignment)) {
+                return block;
+            }
+        } else if (FreeBlock* block = free_lists_[size_class]) {
+            free_lists_[size_class] = block->next;
+            return block;
+        }
+        
+        std::byte* block = align_cursor(block_alignment);
+        if (!block || block_size > static_cast<std::size_t>(limit_ - block)) {
+            add_chunk(block_size + block_alignment);
+            block = align_cursor(block_alignment);
+        }
+        cursor_ = block + block_size;
+        return block;
+    }
+    
+    void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override {
+        const std::size_t size_class = class_of(std::max({bytes, alignment, min_block_size}));
+        
+        std::lock_guard lock(mutex_);
+        if (alignment > page_size()) {
+            over_aligned_ = std::construct_at(static_cast<OverAlignedBlock*>(ptr), 
+                                              OverAlignedBlock{over_aligned_, size_class});
+            return;
+        }
+        free_lists_[size_class] = std::construct_at(static_cast<FreeBlock*>(ptr), 
+                                                    FreeBlock{free_lists_[size_class]});
+    }
+    
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+private:
+    static std::size_t class_of(std::size_t bytes) {
+        const std::size_t size_class = std::bit_width(bytes - 1);
+        if (size_class >= size_classes) {
+            throw std::bad_alloc();
+        }
+        return size_class;
+    }
+    
+    void* reuse_over_aligned(std::size_t size_class, std::size_t alignment) {
+        for (OverAlignedBlock** link = &over_aligned_; *link; link = &(*link)->next) {
+            OverAlignedBlock* block = *link;
+            if (block->size_class == size_class && 
+                reinterpret_cast<std::uintptr_t>(block) % alignment == 0) {
+                *link = block->next;
+                return block;
+            }
+        }
+        return nullptr;
+    }
+    
+    std::byte* align_cursor(std::size_t alignment) const {
+        if (!cursor_) return nullptr;
+        
+        const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(cursor_);
+        const std::uintptr_t aligned = (address + alignment - 1) & ~(alignment - 1);
+        return aligned > reinterpret_cast<std::uintptr_t>(limit_) ? nullptr 
+                                                                   : reinterpret_cast<std::byte*>(aligned);
+    }
+    
+    void add_chunk(std::size_t minimum) {
+        const std::size_t granularity = chunk_granularity();
+        const std::size_t size = (std::max(chunk_size_, minimum + sizeof(Chunk)) + granularity - 1) 
+                               / granularity * granularity;
+        
+        void* memory = map_chunk(size);
+        Chunk* chunk = std::construct_at(static_cast<Chunk*>(memory), Chunk{chunks_, size});
+        chunks_ = chunk;
+        cursor_ = reinterpret_cast<std::byte*>(chunk + 1);
+        limit_ = static_cast<std::byte*>(memory) + size;
+        mapped_bytes_ += size;
+    }
+};
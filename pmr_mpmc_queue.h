@@ -0,0 +1,311 @@
+#pragma once
+#include "pmr_queue.h"
+#include "pmr_wait.h"
+#include <atomic>
+#include <optional>
+#include <vector>
+
+template<typename Node>
+class HazardPointers {
+public:
+    static constexpr std::size_t slots_per_record = 2;
+
+private:
+    struct Record {
+        std::atomic<const void*> hazards[slots_per_record];
+        std::atomic<bool> active;
+        Record* next;
+        std::pmr::vector<Node*> retired;
+        std::pmr::vector<const void*> scratch;
+        
+        Record(std::pmr::memory_resource* mr, Record* n)
+            : active(true), next(n), retired(mr), scratch(mr) {
+            for (auto& hazard : hazards) {
+                hazard.store(nullptr, std::memory_order_relaxed);
+            }
+        }
+    };
+    
+    using record_allocator = std::pmr::polymorphic_allocator<Record>;
+    using node_allocator = std::pmr::polymorphic_allocator<Node>;
+    
+    std::atomic<Record*> records_;
+    std::atomic<std::size_t> record_count_;
+    std::pmr::memory_resource* resource_;
+
+public:
+    class Guard {
+    private:
+        HazardPointers* domain_;
+        Record* record_;
+
+    public:
+        Guard(HazardPointers* domain, Record* record) 
+            : domain_(domain), record_(record) {}
+        
+        ~Guard() {
+            clear();
+            record_->active.store(false, std::memory_order_release);
+        }
+        
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+        
+        template<typename Source>
+        Node* protect(std::size_t slot, const Source& source) {
+            Node* ptr = source.load();
+            while (true) {
+                record_->hazards[slot].store(ptr);
+                Node* current = source.load();
+                if (current == ptr) {
+                    return ptr;
+                }
+                ptr = current;
+            }
+        }
+        
+        void clear() {
+            for (auto& hazard : record_->hazards) {
+                hazard.store(nullptr, std::memory_order_release);
+            }
+        }
+        
+        void retire(Node* node) {
+            record_->retired.push_back(node);
+            if (record_->retired.size() >= domain_->scan_threshold()) {
+                domain_->scan(*record_);
+            }
+        }
+    };
+    
+    explicit HazardPointers(std::pmr::memory_resource* mr = 
+                           std::pmr::get_default_resource())
+        : records_(nullptr), record_count_(0), resource_(mr) {}
+    
+    ~HazardPointers() {
+        node_allocator nodes(resource_);
+        record_allocator records(resource_);
+        
+        Record* record = records_.load(std::memory_order_acquire);
+        while (record) {
+            Record* next = record->next;
+            for (Node* node : record->retired) {
+                nodes.deallocate(node, 1);
+            }
+            std::destroy_at(record);
+            records.deallocate(record, 1);
+            record = next;
+        }
+    }
+    
+    HazardPointers(const HazardPointers&) = delete;
+    HazardPointers& operator=(const HazardPointers&) = delete;
+    
+    Guard acquire() {
+        for (Record* record = records_.load(std::memory_order_acquire); 
+             record; record = record->next) {
+            if (!record->active.load(std::memory_order_relaxed) &&
+                !record->active.exchange(true, std::memory_order_acquire)) {
+                return Guard(this, record);
+            }
+        }
+        
+        record_allocator allocator(resource_);
+        Record* record = allocator.allocate(1);
+        std::construct_at(record, resource_, records_.load(std::memory_order_relaxed));
+        while (!records_.compare_exchange_weak(record->next, record, 
+                                               std::memory_order_release,
+                                               std::memory_order_relaxed)) {
+        }
+        record_count_.fetch_add(1, std::memory_order_relaxed);
+        return Guard(this, record);
+    }
+
+private:
+    std::size_t scan_threshold() const {
+        return std::max<std::size_t>(64, 2 * slots_per_record * 
+                                     record_count_.load(std::memory_order_relaxed));
+    }
+    
+    void scan(Record& owner) {
+        auto& hazards = owner.scratch;
+        hazards.clear();
+        for (Record* record = records_.load(std::memory_order_acquire); 
+             record; record = record->next) {
+            for (const auto& hazard : record->hazards) {
+                if (const void* ptr = hazard.load()) {
+                    hazards.push_back(ptr);
+                }
+            }
+        }
+        std::sort(hazards.begin(), hazards.end());
+        
+        node_allocator nodes(resource_);
+        auto keep = owner.retired.begin();
+        for (Node* node : owner.retired) {
+            if (std::binary_search(hazards.begin(), hazards.end(), 
+                                   static_cast<const void*>(node))) {
+                *keep++ = node;
+            } else {
+                nodes.deallocate(node, 1);
+            }
+        }
+        owner.retired.erase(keep, owner.retired.end());
+    }
+};
+
+template<typename T>
+class MpmcPmrQueue {
+private:
+    using node_type = QueueNode<T>;
+    using allocator_type = std::pmr::polymorphic_allocator<node_type>;
+    using link_type = std::atomic_ref<node_type*>;
+    
+    alignas(cache_line_size) std::atomic<node_type*> head_;
+    alignas(cache_line_size) std::atomic<node_type*> tail_;
+    alignas(cache_line_size) std::atomic<std::size_t> size_;
+    allocator_type allocator_;
+    mutable HazardPointers<node_type> hazards_;
+    EventCount not_empty_;
+
+    static link_type link(node_type* node) {
+        return link_type(node->next);
+    }
+
+public:
+    explicit MpmcPmrQueue(std::pmr::memory_resource* mr = 
+                         std::pmr::get_default_resource())
+        : size_(0), allocator_(mr), hazards_(mr) {
+        // The sentinel only ever has its link read; its value is never constructed.
+        node_type* sentinel = allocator_.allocate(1);
+        std::construct_at(&sentinel->next, nullptr);
+        head_.store(sentinel, std::memory_order_relaxed);
+        tail_.store(sentinel, std::memory_order_relaxed);
+    }
+    
+    ~MpmcPmrQueue() {
+        node_type* node = head_.load(std::memory_order_relaxed);
+        node_type* next = node->next;
+        allocator_.deallocate(node, 1);
+        
+        while (next) {
+            node = next;
+            next = node->next;
+            std::destroy_at(&node->value);
+            allocator_.deallocate(node, 1);
+        }
+    }
+    
+    MpmcPmrQueue(const MpmcPmrQueue&) = delete;
+    MpmcPmrQueue& operator=(const MpmcPmrQueue&) = delete;
+    
+    template<typename U>
+    void push(U&& value) {
+        emplace(std::forward<U>(value));
+    }
+    
+    template<typename... Args>
+    void emplace(Args&&... args) {
+        node_type* new_node = allocator_.allocate(1);
+        try {
+            std::construct_at(new_node, std::allocator_arg, allocator_, 
+                              std::forward<Args>(args)...);
+        } catch (...) {
+            allocator_.deallocate(new_node, 1);
+            throw;
+        }
+        
+        auto guard = hazards_.acquire();
+        while (true) {
+            node_type* tail = guard.protect(0, tail_);
+            node_type* next = link(tail).load(std::memory_order_acquire);
+            if (tail != tail_.load(std::memory_order_acquire)) {
+                continue;
+            }
+            
+            if (next) {
+                tail_.compare_exchange_weak(tail, next);
+                continue;
+            }
+            
+            if (link(tail).compare_exchange_weak(next, new_node, 
+                                                 std::memory_order_release,
+                                                 std::memory_order_relaxed)) {
+                tail_.compare_exchange_strong(tail, new_node);
+                break;
+            }
+        }
+        size_.fetch_add(1, std::memory_order_relaxed);
+        not_empty_.notify_one();
+    }
+    
+    std::optional<T> try_pop() {
+        auto guard = hazards_.acquire();
+        while (true) {
+            node_type* head = guard.protect(0, head_);
+            node_type* tail = tail_.load(std::memory_order_acquire);
+            node_type* next = guard.protect(1, link(head));
+            if (head != head_.load(std::memory_order_acquire)) {
+                continue;
+            }
+            
+            if (!next) {
+                return std::nullopt;
+            }
+            
+            if (head == tail) {
+                tail_.compare_exchange_weak(tail, next);
+                continue;
+            }
+            
+            if (head_.compare_exchange_strong(head, next)) {
+                // Only the winner of the head CAS touches the new sentinel's value.
+                std::optional<T> result(std::move(next->value));
+                std::destroy_at(&next->value);
+                size_.fetch_sub(1, std::memory_order_relaxed);
+                
+                guard.clear();
+                guard.retire(head);
+                return result;
+            }
+        }
+    }
+    
+    bool try_pop(T& out) {
+        std::optional<T> value = try_pop();
+        if (!value) return false;
+        
+        out = std::move(*value);
+        return true;
+    }
+    
+    template<typename Rep, typename Period>
+    bool pop_wait(T& out, const std::chrono::duration<Rep, Period>& timeout) {
+        return not_empty_.await([&] { return try_pop(out); }, wait_deadline(timeout));
+    }
+    
+    template<typename Rep, typename Period>
+    std::optional<T> pop_wait(const std::chrono::duration<Rep, Period>& timeout) {
+        std::optional<T> result;
+        (void)not_empty_.await([&] { return (result = try_pop()).has_value(); },
+                               wait_deadline(timeout));
+        return result;
+    }
+    
+    T pop_wait() {
+        std::optional<T> result;
+        (void)not_empty_.await([&] { return (result = try_pop()).has_value(); },
+                               EventCount::clock::time_point::max());
+        return std::move(*result);
+    }
+    
+    bool empty() const {
+        auto guard = hazards_.acquire();
+        node_type* head = guard.protect(0, head_);
+        return link(head).load(std::memory_order_acquire) == nullptr;
+    }
+    
+    std::size_t size() const {
+        return size_.load(std::memory_order_relaxed);
+    }
+};
@@ -0,0 +1,155 @@
+#pragma once
+#include "pmr_mapped_resource.h"
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+inline int numa_node_count() {
+    std::ifstream online("/sys/devices/system/node/online");
+    std::string ranges;
+    if (!(online >> ranges)) {
+        return 1;
+    }
+    
+    int highest = 0;
+    std::size_t start = 0;
+    while (start < ranges.size()) {
+        std::size_t end = ranges.find(',', start);
+        if (end == std::string::npos) {
+            end = ranges.size();
+        }
+        const std::string range = ranges.substr(start, end - start);
+        const std::size_t dash = range.find('-');
+        highest = std::max(highest, std::stoi(dash == std::string::npos ? range : range.substr(dash + 1)));
+        start = end + 1;
+    }
+    return highest + 1;
+}
+
+inline int current_numa_node() {
+    unsigned cpu = 0;
+    unsigned node = 0;
+    if (::syscall(SYS_getcpu, &cpu, &node, nullptr) != 0) {
+        return 0;
+    }
+    return static_cast<int>(node);
+}
+
+inline int numa_node_of_cpu(int cpu) {
+    const int nodes = numa_node_count();
+    for (int node = 0; node < nodes; ++node) {
+        std::ifstream cpulist("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+        std::string ranges;
+        if (!(cpulist >> ranges)) continue;
+        
+        std::size_t start = 0;
+        while (start < ranges.size()) {
+            std::size_t end = ranges.find(',', start);
+            if (end == std::string::npos) {
+                end = ranges.size();
+            }
+            const std::string range = ranges.substr(start, end - start);
+            const std::size_t dash = range.find('-');
+            const int first = std::stoi(range.substr(0, dash));
+            const int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+            if (cpu >= first && cpu <= last) {
+                return node;
+            }
+            start = end + 1;
+        }
+    }
+    return 0;
+}
+
+class NumaLocalResource : public MappedChunkResource {
+private:
+    int node_;
+    std::atomic<bool> bound_;
+
+public:
+    explicit NumaLocalResource(int node, std::size_t chunk_size = 2 * 1024 * 1024)
+        : MappedChunkResource(chunk_size), node_(node), bound_(true) {
+        if (node < 0 || node >= numa_node_count()) {
+            throw std::invalid_argument("NUMA node " + std::to_string(node) + " is not online");
+        }
+    }
+    
+    int node() const { 
+        return node_; 
+    }
+    
+    // False once mbind has been refused; placement then falls back to first touch.
+    bool bound() const {
+        return bound_.load(std::memory_order_relaxed);
+    }
+
+protected:
+    void* map_chunk(std::size_t size) override {
+        void* memory = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, 
+                              MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (memory == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        
+        // Binding before the first write means every page faults in on the chosen node.
+        if (bound()) {
+            std::array<unsigned long, 16> mask{};
+            const std::size_t bits = sizeof(unsigned long) * CHAR_BIT;
+            bool bound = false;
+            if (static_cast<std::size_t>(node_) < mask.size() * bits) {
+                mask[node_ / bits] = 1UL << (node_ % bits);
+                bound = ::syscall(SYS_mbind, memory, size, MPOL_PREFERRED, mask.data(), 
+                                  mask.size() * bits, 0) == 0;
+            }
+            bound_.store(bound, std::memory_order_relaxed);
+        }
+        return memory;
+    }
+};
+
+// One lazily created NumaLocalResource per node, so each queue can allocate on its consumer's node.
+class NumaArenaSet {
+private:
+    std::size_t chunk_size_;
+    std::vector<std::unique_ptr<NumaLocalResource>> arenas_;
+    std::mutex mutex_;
+
+public:
+    explicit NumaArenaSet(std::size_t chunk_size = 2 * 1024 * 1024)
+        : chunk_size_(chunk_size), arenas_(static_cast<std::size_t>(numa_node_count())) {}
+    
+    std::size_t node_count() const { 
+        return arenas_.size(); 
+    }
+    
+    NumaLocalResource* resource_for_node(int node) {
+        if (node < 0 || static_cast<std::size_t>(node) >= arenas_.size()) {
+            throw std::invalid_argument("NUMA node " + std::to_string(node) + " is not online");
+        }
+        
+        std::lock_guard lock(mutex_);
+        auto& arena = arenas_[static_cast<std::size_t>(node)];
+        if (!arena) {
+            arena = std::make_unique<NumaLocalResource>(node, chunk_size_);
+        }
+        return arena.get();
+    }
+    
+    NumaLocalResource* resource_for_cpu(int cpu) {
+        return resource_for_node(numa_node_of_cpu(cpu));
+    }
+    
+    // Call from the consumer thread to place a queue next to the thread that drains it.
+    NumaLocalResource* local_resource() {
+        return resource_for_node(current_numa_node());
+    }
+};
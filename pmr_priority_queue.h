@@ -0,0 +1,177 @@
+#pragma once
+#include "pmr_queue.h"
+#include <vector>
+
+template<typename T, typename Compare = std::less<T>, std::size_t Arity = 4>
+class PmrPriorityQueue {
+    static_assert(Arity >= 2, "heap arity must be at least 2");
+
+public:
+    using container_type = std::pmr::vector<T>;
+    using value_compare = Compare;
+    using const_iterator = typename container_type::const_iterator;
+    
+    static constexpr std::size_t arity = Arity;
+
+private:
+    container_type heap_;
+    Compare compare_;
+
+public:
+    explicit PmrPriorityQueue(std::pmr::memory_resource* mr = 
+                             std::pmr::get_default_resource())
+        : heap_(mr), compare_() {}
+    
+    explicit PmrPriorityQueue(const Compare& compare,
+                             std::pmr::memory_resource* mr = 
+                             std::pmr::get_default_resource())
+        : heap_(mr), compare_(compare) {}
+    
+    template<typename U>
+    void push(U&& value) {
+        emplace(std::forward<U>(value));
+    }
+    
+    template<typename... Args>
+    void emplace(Args&&... args) {
+        heap_.emplace_back(std::forward<Args>(args)...);
+        sift_up(heap_.size() - 1);
+    }
+    
+    template<typename InputIt>
+    void push_range(InputIt first, InputIt last) {
+        const std::size_t old_size = heap_.size();
+        heap_.insert(heap_.end(), first, last);
+        const std::size_t added = heap_.size() - old_size;
+        
+        if (added >= old_size) {
+            heapify();
+        } else {
+            for (std::size_t i = old_size; i < heap_.size(); ++i) {
+                sift_up(i);
+            }
+        }
+    }
+    
+    const T& top() const { 
+        return heap_.front(); 
+    }
+    
+    std::optional<std::reference_wrapper<const T>> try_top() const {
+        if (heap_.empty()) return std::nullopt;
+        return std::cref(heap_.front());
+    }
+    
+    void pop() {
+        (void)try_pop();
+    }
+    
+    [[nodiscard]] bool try_pop() {
+        if (heap_.empty()) return false;
+        
+        if (heap_.size() > 1) {
+            T last = std::move(heap_.back());
+            heap_.pop_back();
+            sift_down(0, std::move(last));
+        } else {
+            heap_.pop_back();
+        }
+        return true;
+    }
+    
+    [[nodiscard]] bool try_pop(T& out) {
+        if (heap_.empty()) return false;
+        
+        out = std::move(heap_.front());
+        (void)try_pop();
+        return true;
+    }
+    
+    T pop_value() {
+        T value(std::move(heap_.front()));
+        pop();
+        return value;
+    }
+    
+    bool empty() const { 
+        return heap_.empty(); 
+    }
+    
+    std::size_t size() const { 
+        return heap_.size(); 
+    }
+    
+    void reserve(std::size_t n) {
+        heap_.reserve(n);
+    }
+    
+    void clear() {
+        heap_.clear();
+    }
+    
+    std::pmr::memory_resource* get_resource() const {
+        return heap_.get_allocator().resource();
+    }
+    
+    // Iteration visits elements in heap order, not priority order.
+    const_iterator begin() const { 
+        return heap_.begin(); 
+    }
+    
+    const_iterator end() const { 
+        return heap_.end(); 
+    }
+
+private:
+    static std::size_t parent(std::size_t index) {
+        return (index - 1) / Arity;
+    }
+    
+    static std::size_t first_child(std::size_t index) {
+        return index * Arity + 1;
+    }
+    
+    void sift_up(std::size_t index) {
+        T value = std::move(heap_[index]);
+        while (index > 0) {
+            const std::size_t up = parent(index);
+            if (!compare_(heap_[up], value)) break;
+            
+            heap_[index] = std::move(heap_[up]);
+            index = up;
+        }
+        heap_[index] = std::move(value);
+    }
+    
+    // Moves the hole at index down until value fits, comparing all Arity siblings per level.
+    void sift_down(std::size_t index, T value) {
+        const std::size_t count = heap_.size();
+        while (true) {
+            const std::size_t child = first_child(index);
+            if (child >= count) break;
+            
+            const std::size_t last = std::min(child + Arity, count);
+            std::size_t best = child;
+            for (std::size_t i = child + 1; i < last; ++i) {
+                if (compare_(heap_[best], heap_[i])) {
+                    best = i;
+                }
+            }
+            
+            if (!compare_(value, heap_[best])) break;
+            
+            heap_[index] = std::move(heap_[best]);
+            index = best;
+        }
+        heap_[index] = std::move(value);
+    }
+    
+    void heapify() {
+        if (heap_.size() < 2) return;
+        
+        for (std::size_t i = parent(heap_.size() - 1) + 1; i-- > 0;) {
+            T value = std::move(heap_[i]);
+            sift_down(i, std::move(value));
+        }
+    }
+};
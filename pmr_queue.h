@@ -1,162 +1,1385 @@
 #pragma once
 #include <memory_resource>
-#include <list>
+#include <unordered_map>
 #include <iterator>
+#include <functional>
+#include <optional>
+#include <memory>
+#include <new>
+#include <type_traits>
 #include <iostream>
+#include <string>
+#include <string_view>
+#include <initializer_list>
 #include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <mutex>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <vector>
+#include <limits>
+#include <stdexcept>
+#include <span>
+#include <ranges>
+#include <numeric>
+#include <execution>
 
+#ifndef PMR_QUEUE_STATS
+#ifdef NDEBUG
+#define PMR_QUEUE_STATS 0
+#else
+#define PMR_QUEUE_STATS 1
+#endif
+#endif
+
+// Tracing stays on in release builds: an unattached queue pays one null check per op.
+#ifndef PMR_QUEUE_TRACING
+#define PMR_QUEUE_TRACING 1
+#endif
+
+inline constexpr std::size_t cache_line_size = 64;
+
+struct AllocationStats {
+    static constexpr std::size_t histogram_buckets = 32;
+    
+    std::size_t live_bytes = 0;
+    std::size_t peak_bytes = 0;
+    std::size_t allocations = 0;
+    std::size_t deallocations = 0;
+    std::size_t unmatched_deallocations = 0;
+    std::array<std::size_t, histogram_buckets> size_histogram{};
+    std::array<std::size_t, histogram_buckets> alignment_histogram{};
+    
+    static std::size_t bucket(std::size_t value) {
+        return std::min<std::size_t>(std::bit_width(value), histogram_buckets - 1);
+    }
+    
+    void record_allocation(std::size_t bytes, std::size_t alignment) {
+        ++allocations;
+        live_bytes += bytes;
+        peak_bytes = std::max(peak_bytes, live_bytes);
+        ++size_histogram[bucket(bytes)];
+        ++alignment_histogram[bucket(alignment)];
+    }
+    
+    void record_deallocation(std::size_t bytes, bool matched) {
+        if (!matched) {
+            ++unmatched_deallocations;
+            return;
+        }
+        ++deallocations;
+        live_bytes -= bytes;
+    }
+};
+
+inline std::uint64_t queue_trace_now() {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// Hooks invoked by PmrQueue when PMR_QUEUE_TRACING is on and an instrumentation is attached.
+// Residency is only known for queues whose nodes carry enqueue timestamps.
+class QueueInstrumentation {
+public:
+    virtual ~QueueInstrumentation() = default;
+    
+    virtual void on_push(std::uint64_t latency_ns, std::size_t depth) = 0;
+    virtual void on_pop(std::uint64_t latency_ns, std::size_t depth, 
+                        std::optional<std::uint64_t> residency_ns) = 0;
+};
+
+enum class BlockTracking {
+    indexed,
+    inline_header
+};
+
+struct DynamicMemoryResourceOptions {
+    BlockTracking tracking = BlockTracking::indexed;
+    bool synchronized = false;
+    // Caps user bytes plus inline headers; the indexed mode's hash map is not counted.
+    std::size_t byte_budget = std::numeric_limits<std::size_t>::max();
+};
+
+// Tracks every live block so misdirected frees are caught and the rest released on
+// destruction. Indexed mode looks pointers up and counts foreign ones as unmatched;
+// inline_header mode reads the header in front of the pointer, so it must only be given
+// pointers it allocated and never reports unmatched deallocations.
 class DynamicMemoryResource : public std::pmr::memory_resource {
 private:
     struct BlockInfo {
+        std::size_t size;
+        std::size_t alignment;
+        BlockInfo(std::size_t s, std::size_t a) : size(s), alignment(a) {}
+    };
+    
+    struct BlockHeader {
+        BlockHeader* prev;
+        BlockHeader* next;
+        std::size_t size;
+        std::size_t alignment;
+        std::size_t offset;
+        std::uintptr_t cookie;
+    };
+    
+    static constexpr std::uintptr_t header_magic = 0x5a17c0de5a17c0deULL;
+    
+    std::pmr::memory_resource* upstream_;
+    DynamicMemoryResourceOptions options_;
+    std::pmr::unordered_map<void*, BlockInfo> allocated_blocks_;
+    BlockHeader* header_list_;
+    std::size_t bytes_in_use_;
+    mutable std::mutex mutex_;
+#if PMR_QUEUE_STATS
+    AllocationStats stats_;
+#endif
+
+public:
+    static constexpr bool stats_enabled = PMR_QUEUE_STATS != 0;
+
+    explicit DynamicMemoryResource(std::pmr::memory_resource* upstream = 
+                                  std::pmr::get_default_resource()) 
+        : DynamicMemoryResource(DynamicMemoryResourceOptions{}, upstream) {}
+    
+    explicit DynamicMemoryResource(const DynamicMemoryResourceOptions& options,
+                                  std::pmr::memory_resource* upstream = 
+                                  std::pmr::get_default_resource()) 
+        : upstream_(upstream), options_(options), 
+          allocated_blocks_(upstream), header_list_(nullptr), bytes_in_use_(0) {}
+    
+    DynamicMemoryResource(const DynamicMemoryResource&) = delete;
+    DynamicMemoryResource& operator=(const DynamicMemoryResource&) = delete;
+    
+    ~DynamicMemoryResource() override {
+        for (const auto& [ptr, block] : allocated_blocks_) {
+            upstream_->deallocate(ptr, block.size, block.alignment);
+        }
+        
+        while (header_list_) {
+            BlockHeader* header = header_list_;
+            header_list_ = header->next;
+            upstream_->deallocate(raw_block(header), header->size, header->alignment);
+        }
+    }
+    
+    BlockTracking tracking() const { 
+        return options_.tracking; 
+    }
+    
+    bool synchronized() const { 
+        return options_.synchronized; 
+    }
+    
+    std::size_t byte_budget() const { 
+        return options_.byte_budget; 
+    }
+    
+    // Bytes charged against the budget: user blocks plus any inline headers.
+    std::size_t bytes_in_use() const {
+        auto lock = lock_if_synchronized();
+        return bytes_in_use_;
+    }
+    
+    AllocationStats stats() const {
+#if PMR_QUEUE_STATS
+        auto lock = lock_if_synchronized();
+        return stats_;
+#else
+        return AllocationStats{};
+#endif
+    }
+    
+    void reset_stats() {
+#if PMR_QUEUE_STATS
+        auto lock = lock_if_synchronized();
+        std::size_t live_bytes = stats_.live_bytes;
+        stats_ = AllocationStats{};
+        stats_.live_bytes = live_bytes;
+        stats_.peak_bytes = live_bytes;
+#endif
+    }
+
+protected:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        auto lock = lock_if_synchronized();
+        
+        const std::size_t footprint = options_.tracking == BlockTracking::inline_header 
+                                    ? header_offset(alignment) + bytes : bytes;
+        if (footprint > options_.byte_budget - bytes_in_use_) {
+            throw std::bad_alloc();
+        }
+        
         void* ptr;
+        if (options_.tracking == BlockTracking::inline_header) {
+            ptr = allocate_with_header(bytes, alignment);
+        } else {
+            ptr = upstream_->allocate(bytes, alignment);
+            try {
+                allocated_blocks_.emplace(ptr, BlockInfo(bytes, alignment));
+            } catch (...) {
+                upstream_->deallocate(ptr, bytes, alignment);
+                throw;
+            }
+        }
+        bytes_in_use_ += footprint;
+        
+#if PMR_QUEUE_STATS
+        stats_.record_allocation(bytes, alignment);
+#endif
+        return ptr;
+    }
+    
+    void do_deallocate(void* ptr, [[maybe_unused]] std::size_t bytes, 
+                      [[maybe_unused]] std::size_t alignment) override {
+        auto lock = lock_if_synchronized();
+        
+        bool matched = false;
+        if (options_.tracking == BlockTracking::inline_header) {
+            matched = deallocate_with_header(ptr);
+        } else {
+            auto it = allocated_blocks_.find(ptr);
+            
+            if (it != allocated_blocks_.end()) {
+                upstream_->deallocate(ptr, it->second.size, it->second.alignment);
+                bytes_in_use_ -= it->second.size;
+                allocated_blocks_.erase(it);
+                matched = true;
+            }
+        }
+        
+#if PMR_QUEUE_STATS
+        if (matched || options_.tracking == BlockTracking::indexed) {
+            stats_.record_deallocation(bytes, matched);
+        }
+#else
+        (void)matched;
+#endif
+    }
+    
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+private:
+    std::unique_lock<std::mutex> lock_if_synchronized() const {
+        if (options_.synchronized) {
+            return std::unique_lock<std::mutex>(mutex_);
+        }
+        return std::unique_lock<std::mutex>();
+    }
+    
+    static void* raw_block(BlockHeader* header) {
+        return reinterpret_cast<std::byte*>(header + 1) - header->offset;
+    }
+    
+    static std::size_t header_offset(std::size_t alignment) {
+        std::size_t raw_alignment = std::max(alignment, alignof(BlockHeader));
+        return (sizeof(BlockHeader) + raw_alignment - 1) & ~(raw_alignment - 1);
+    }
+    
+    void* allocate_with_header(std::size_t bytes, std::size_t alignment) {
+        std::size_t raw_alignment = std::max(alignment, alignof(BlockHeader));
+        std::size_t offset = header_offset(alignment);
+        std::size_t raw_size = offset + bytes;
+        
+        std::byte* raw = static_cast<std::byte*>(upstream_->allocate(raw_size, raw_alignment));
+        std::byte* user = raw + offset;
+        
+        BlockHeader* header = reinterpret_cast<BlockHeader*>(user) - 1;
+        header->prev = nullptr;
+        header->next = header_list_;
+        header->size = raw_size;
+        header->alignment = raw_alignment;
+        header->offset = offset;
+        header->cookie = reinterpret_cast<std::uintptr_t>(header) ^ header_magic;
+        
+        if (header_list_) {
+            header_list_->prev = header;
+        }
+        header_list_ = header;
+        return user;
+    }
+    
+    bool deallocate_with_header(void* ptr) {
+        if (!ptr) return false;
+        
+        BlockHeader* header = static_cast<BlockHeader*>(ptr) - 1;
+        if (header->cookie != (reinterpret_cast<std::uintptr_t>(header) ^ header_magic)) {
+            return false;
+        }
+        
+        if (header->prev) {
+            header->prev->next = header->next;
+        } else {
+            header_list_ = header->next;
+        }
+        if (header->next) {
+            header->next->prev = header->prev;
+        }
+        
+        header->cookie = 0;
+        bytes_in_use_ -= header->size;
+        upstream_->deallocate(raw_block(header), header->size, header->alignment);
+        return true;
+    }
+};
+
+class NodePoolResource : public std::pmr::memory_resource {
+private:
+    struct FreeNode {
+        FreeNode* next;
+    };
+    
+    struct Slab {
+        Slab* next;
+    };
+    
+    std::pmr::memory_resource* upstream_;
+    std::size_t node_size_;
+    std::size_t node_alignment_;
+    std::size_t nodes_per_slab_;
+    std::size_t slab_offset_;
+    std::size_t slab_bytes_;
+    std::size_t slab_alignment_;
+    FreeNode* free_list_;
+    Slab* slabs_;
+    std::size_t slab_count_;
+    std::byte* bump_;
+    std::byte* bump_end_;
+
+    static std::size_t round_up(std::size_t value, std::size_t alignment) {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+public:
+    explicit NodePoolResource(std::size_t node_size, 
+                             std::size_t node_alignment = alignof(std::max_align_t),
+                             std::size_t nodes_per_slab = 256,
+                             std::pmr::memory_resource* upstream = 
+                             std::pmr::get_default_resource())
+        : upstream_(upstream),
+          node_alignment_(std::max(node_alignment, alignof(FreeNode))),
+          nodes_per_slab_(std::max<std::size_t>(nodes_per_slab, 1)),
+          free_list_(nullptr), slabs_(nullptr), slab_count_(0),
+          bump_(nullptr), bump_end_(nullptr) {
+        node_size_ = round_up(std::max(node_size, sizeof(FreeNode)), node_alignment_);
+        slab_alignment_ = std::max(node_alignment_, alignof(Slab));
+        slab_offset_ = round_up(sizeof(Slab), node_alignment_);
+        slab_bytes_ = slab_offset_ + node_size_ * nodes_per_slab_;
+    }
+    
+    NodePoolResource(const NodePoolResource&) = delete;
+    NodePoolResource& operator=(const NodePoolResource&) = delete;
+    
+    ~NodePoolResource() override {
+        while (slabs_) {
+            Slab* slab = slabs_;
+            slabs_ = slab->next;
+            upstream_->deallocate(slab, slab_bytes_, slab_alignment_);
+        }
+    }
+    
+    std::size_t node_size() const { 
+        return node_size_; 
+    }
+    
+    std::size_t nodes_per_slab() const { 
+        return nodes_per_slab_; 
+    }
+    
+    std::size_t slab_count() const { 
+        return slab_count_; 
+    }
+
+protected:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        if (bytes > node_size_ || alignment > node_alignment_) {
+            return upstream_->allocate(bytes, alignment);
+        }
+        
+        if (free_list_) {
+            FreeNode* node = free_list_;
+            free_list_ = node->next;
+            return node;
+        }
+        
+        if (bump_ == bump_end_) {
+            add_slab();
+        }
+        void* ptr = bump_;
+        bump_ += node_size_;
+        return ptr;
+    }
+    
+    void do_deallocate(void* ptr, std::size_t bytes, 
+                      std::size_t alignment) override {
+        if (bytes > node_size_ || alignment > node_alignment_) {
+            upstream_->deallocate(ptr, bytes, alignment);
+            return;
+        }
+        
+        FreeNode* node = static_cast<FreeNode*>(ptr);
+        node->next = free_list_;
+        free_list_ = node;
+    }
+    
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+private:
+    void add_slab() {
+        Slab* slab = static_cast<Slab*>(upstream_->allocate(slab_bytes_, slab_alignment_));
+        slab->next = slabs_;
+        slabs_ = slab;
+        ++slab_count_;
+        
+        bump_ = reinterpret_cast<std::byte*>(slab) + slab_offset_;
+        bump_end_ = bump_ + node_size_ * nodes_per_slab_;
+    }
+};
+
+class ArenaResource : public std::pmr::memory_resource {
+private:
+    struct Chunk {
+        Chunk* next;
         std::size_t size;
-        BlockInfo(void* p, std::size_t s) : ptr(p), size(s) {}
+        
+        std::byte* data() {
+            return reinterpret_cast<std::byte*>(this + 1);
+        }
     };
     
-    std::list<BlockInfo> allocated_blocks_;
-    std::pmr::memory_resource* upstream_;
-
-public:
-    explicit DynamicMemoryResource(std::pmr::memory_resource* upstream = 
-                                  std::pmr::get_default_resource()) 
-        : upstream_(upstream) {}
+    std::pmr::memory_resource* upstream_;
+    std::size_t next_chunk_size_;
+    Chunk* chunks_;
+    Chunk* last_;
+    Chunk* current_;
+    std::byte* bump_;
+    std::byte* bump_end_;
+    std::size_t reserved_bytes_;
+
+public:
+    explicit ArenaResource(std::size_t initial_chunk_size = 64 * 1024,
+                          std::pmr::memory_resource* upstream = 
+                          std::pmr::get_default_resource())
+        : upstream_(upstream), 
+          next_chunk_size_(std::max<std::size_t>(initial_chunk_size, 64)),
+          chunks_(nullptr), last_(nullptr), current_(nullptr),
+          bump_(nullptr), bump_end_(nullptr), reserved_bytes_(0) {}
+    
+    ArenaResource(const ArenaResource&) = delete;
+    ArenaResource& operator=(const ArenaResource&) = delete;
+    
+    ~ArenaResource() override {
+        release();
+    }
+    
+    void reset() {
+        current_ = chunks_;
+        if (current_) {
+            bump_ = current_->data();
+            bump_end_ = bump_ + current_->size;
+        }
+    }
+    
+    void release() {
+        while (chunks_) {
+            Chunk* chunk = chunks_;
+            chunks_ = chunk->next;
+            upstream_->deallocate(chunk, sizeof(Chunk) + chunk->size, alignof(std::max_align_t));
+        }
+        last_ = nullptr;
+        current_ = nullptr;
+        bump_ = nullptr;
+        bump_end_ = nullptr;
+        reserved_bytes_ = 0;
+    }
+    
+    std::size_t reserved_bytes() const { 
+        return reserved_bytes_; 
+    }
+
+protected:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        if (void* ptr = bump(bytes, alignment)) {
+            return ptr;
+        }
+        
+        while (current_ && current_->next) {
+            current_ = current_->next;
+            bump_ = current_->data();
+            bump_end_ = bump_ + current_->size;
+            if (void* ptr = bump(bytes, alignment)) {
+                return ptr;
+            }
+        }
+        
+        add_chunk(bytes + alignment);
+        return bump(bytes, alignment);
+    }
+    
+    void do_deallocate(void*, std::size_t, std::size_t) override {}
+    
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+private:
+    void* bump(std::size_t bytes, std::size_t alignment) {
+        void* ptr = bump_;
+        std::size_t space = static_cast<std::size_t>(bump_end_ - bump_);
+        if (!ptr || !std::align(alignment, bytes, ptr, space)) {
+            return nullptr;
+        }
+        bump_ = static_cast<std::byte*>(ptr) + bytes;
+        return ptr;
+    }
+    
+    void add_chunk(std::size_t min_bytes) {
+        std::size_t size = std::max(next_chunk_size_, min_bytes);
+        size = (size + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+        
+        Chunk* chunk = static_cast<Chunk*>(
+            upstream_->allocate(sizeof(Chunk) + size, alignof(std::max_align_t)));
+        chunk->next = nullptr;
+        chunk->size = size;
+        
+        if (last_) {
+            last_->next = chunk;
+        } else {
+            chunks_ = chunk;
+        }
+        last_ = chunk;
+        current_ = chunk;
+        bump_ = chunk->data();
+        bump_end_ = bump_ + size;
+        reserved_bytes_ += size;
+        next_chunk_size_ *= 2;
+    }
+};
+
+template<typename T, std::size_t Alignment = alignof(T)>
+struct alignas(std::max({Alignment, alignof(T), alignof(void*)})) QueueNode {
+    T value;
+    QueueNode* next;
+    
+    template<typename... Args>
+    QueueNode(Args&&... args) 
+        : value(std::forward<Args>(args)...), next(nullptr) {}
+    
+    template<typename Alloc, typename... Args>
+    QueueNode(std::allocator_arg_t, Alloc&& alloc, Args&&... args) 
+        : value(std::make_obj_using_allocator<T>(alloc, std::forward<Args>(args)...)), 
+          next(nullptr) {}
+};
+
+template<typename T>
+struct TimestampedQueueNode {
+    T value;
+    TimestampedQueueNode* next;
+    std::uint64_t enqueued_at;
+    
+    template<typename... Args>
+    TimestampedQueueNode(Args&&... args) 
+        : value(std::forward<Args>(args)...), next(nullptr), enqueued_at(queue_trace_now()) {}
+    
+    template<typename Alloc, typename... Args>
+    TimestampedQueueNode(std::allocator_arg_t, Alloc&& alloc, Args&&... args) 
+        : value(std::make_obj_using_allocator<T>(alloc, std::forward<Args>(args)...)), 
+          next(nullptr), enqueued_at(queue_trace_now()) {}
+};
+
+template<typename T, std::size_t Alignment = alignof(T)>
+class QueueNodePoolResource : public NodePoolResource {
+public:
+    explicit QueueNodePoolResource(std::size_t nodes_per_slab = 256,
+                                  std::pmr::memory_resource* upstream = 
+                                  std::pmr::get_default_resource())
+        : NodePoolResource(sizeof(QueueNode<T, Alignment>), alignof(QueueNode<T, Alignment>), 
+                           nodes_per_slab, upstream) {}
+};
+
+template<typename T, typename Node = QueueNode<std::remove_const_t<T>>>
+class QueueIterator {
+private:
+    Node* current_;
+
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::remove_const_t<T>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = T*;
+    using reference = T&;
+
+    explicit QueueIterator(Node* node = nullptr) : current_(node) {}
+
+    QueueIterator& operator++() {
+        if (current_) {
+            current_ = current_->next;
+        }
+        return *this;
+    }
+
+    QueueIterator operator++(int) {
+        QueueIterator temp = *this;
+        ++(*this);
+        return temp;
+    }
+
+    reference operator*() const { 
+        return current_->value; 
+    }
+    
+    pointer operator->() const { 
+        return &current_->value; 
+    }
+
+    bool operator==(const QueueIterator& other) const {
+        return current_ == other.current_;
+    }
+    
+    bool operator!=(const QueueIterator& other) const {
+        return !(*this == other);
+    }
+};
+
+struct NodeStorage {};
+
+template<std::size_t Alignment>
+struct AlignedNodeStorage {
+    static_assert(std::has_single_bit(Alignment), "node alignment must be a power of two");
+};
+
+struct TimestampedNodeStorage {};
+
+template<typename T, typename Storage>
+struct node_storage_traits;
+
+template<typename T>
+struct node_storage_traits<T, NodeStorage> {
+    using node_type = QueueNode<T>;
+};
+
+template<typename T, std::size_t Alignment>
+struct node_storage_traits<T, AlignedNodeStorage<Alignment>> {
+    using node_type = QueueNode<T, Alignment>;
+};
+
+template<typename T>
+struct node_storage_traits<T, TimestampedNodeStorage> {
+    using node_type = TimestampedQueueNode<T>;
+};
+
+template<std::size_t ChunkCapacity>
+struct ChunkedStorage {
+    static_assert(ChunkCapacity > 0, "chunk capacity must be positive");
+};
+
+template<typename T, std::size_t Capacity>
+struct QueueChunk {
+    QueueChunk* next;
+    std::size_t end;
+    alignas(T) std::byte storage[sizeof(T) * Capacity];
+    
+    QueueChunk() : next(nullptr), end(0) {}
+    
+    T* slot(std::size_t index) {
+        return std::launder(reinterpret_cast<T*>(storage)) + index;
+    }
+};
+
+template<typename T, typename Chunk>
+class ChunkedQueueIterator {
+private:
+    Chunk* chunk_;
+    std::size_t index_;
+
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::remove_const_t<T>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = T*;
+    using reference = T&;
+
+    explicit ChunkedQueueIterator(Chunk* chunk = nullptr, std::size_t index = 0) 
+        : chunk_(chunk), index_(index) {}
+
+    ChunkedQueueIterator& operator++() {
+        if (chunk_ && ++index_ == chunk_->end) {
+            chunk_ = chunk_->next;
+            index_ = 0;
+        }
+        return *this;
+    }
+
+    ChunkedQueueIterator operator++(int) {
+        ChunkedQueueIterator temp = *this;
+        ++(*this);
+        return temp;
+    }
+
+    reference operator*() const { 
+        return *chunk_->slot(index_); 
+    }
+    
+    pointer operator->() const { 
+        return chunk_->slot(index_); 
+    }
+
+    bool operator==(const ChunkedQueueIterator& other) const {
+        return chunk_ == other.chunk_ && index_ == other.index_;
+    }
+    
+    bool operator!=(const ChunkedQueueIterator& other) const {
+        return !(*this == other);
+    }
+};
+
+template<typename T, typename Chunk>
+class ChunkedSegmentIterator {
+private:
+    Chunk* chunk_;
+    std::size_t index_;
+
+public:
+    using iterator_concept = std::forward_iterator_tag;
+    using iterator_category = std::input_iterator_tag;
+    using value_type = std::span<T>;
+    using difference_type = std::ptrdiff_t;
+    using reference = std::span<T>;
+
+    explicit ChunkedSegmentIterator(Chunk* chunk = nullptr, std::size_t index = 0) 
+        : chunk_(chunk), index_(index) {}
+
+    ChunkedSegmentIterator& operator++() {
+        chunk_ = chunk_->next;
+        index_ = 0;
+        return *this;
+    }
+
+    ChunkedSegmentIterator operator++(int) {
+        ChunkedSegmentIterator temp = *this;
+        ++(*this);
+        return temp;
+    }
+
+    reference operator*() const { 
+        return reference(chunk_->slot(index_), chunk_->end - index_); 
+    }
+
+    bool operator==(const ChunkedSegmentIterator& other) const {
+        return chunk_ == other.chunk_ && index_ == other.index_;
+    }
+};
+
+struct PmrQueueOptions {
+    std::size_t capacity = std::numeric_limits<std::size_t>::max();
+    std::size_t node_cache_limit = 0;
+};
+
+template<typename T, typename Storage = NodeStorage>
+class PmrQueue {
+private:
+    using node_type = typename node_storage_traits<T, Storage>::node_type;
+    using allocator_type = std::pmr::polymorphic_allocator<node_type>;
+    
+    struct CachedNode {
+        CachedNode* next;
+    };
+    
+    node_type* head_;
+    node_type* tail_;
+    allocator_type allocator_;
+    std::size_t size_;
+    std::size_t capacity_;
+    CachedNode* node_cache_;
+    std::size_t cached_nodes_;
+    std::size_t node_cache_limit_;
+#if PMR_QUEUE_TRACING
+    QueueInstrumentation* instrumentation_ = nullptr;
+#endif
+
+    static constexpr bool timestamped = requires(node_type* node) { node->enqueued_at; };
+
+public:
+    using iterator = QueueIterator<T, node_type>;
+    using const_iterator = QueueIterator<const T, node_type>;
+    
+    static constexpr bool tracing_enabled = PMR_QUEUE_TRACING != 0;
+
+    explicit PmrQueue(std::pmr::memory_resource* mr = 
+                     std::pmr::get_default_resource()) 
+        : PmrQueue(PmrQueueOptions{}, mr) {}
+    
+    explicit PmrQueue(const PmrQueueOptions& options,
+                     std::pmr::memory_resource* mr = 
+                     std::pmr::get_default_resource()) 
+        : head_(nullptr), tail_(nullptr), allocator_(mr), size_(0), 
+          capacity_(options.capacity), node_cache_(nullptr), cached_nodes_(0),
+          node_cache_limit_(options.node_cache_limit) {}
+    
+    ~PmrQueue() {
+        clear();
+        shrink_to_fit();
+    }
+    
+    PmrQueue(const PmrQueue&) = delete;
+    PmrQueue& operator=(const PmrQueue&) = delete;
+    
+    PmrQueue(PmrQueue&& other) noexcept 
+        : head_(other.head_), tail_(other.tail_), 
+          allocator_(other.allocator_), size_(other.size_), capacity_(other.capacity_),
+          node_cache_(other.node_cache_), cached_nodes_(other.cached_nodes_),
+          node_cache_limit_(other.node_cache_limit_) {
+#if PMR_QUEUE_TRACING
+        instrumentation_ = other.instrumentation_;
+#endif
+        other.head_ = nullptr;
+        other.tail_ = nullptr;
+        other.size_ = 0;
+        other.node_cache_ = nullptr;
+        other.cached_nodes_ = 0;
+    }
+    
+    PmrQueue& operator=(PmrQueue&& other) noexcept {
+        if (this != &other) {
+            clear();
+            shrink_to_fit();
+            head_ = other.head_;
+            tail_ = other.tail_;
+            std::destroy_at(&allocator_);
+            std::construct_at(&allocator_, other.allocator_);
+            size_ = other.size_;
+            capacity_ = other.capacity_;
+            node_cache_ = other.node_cache_;
+            cached_nodes_ = other.cached_nodes_;
+            node_cache_limit_ = other.node_cache_limit_;
+#if PMR_QUEUE_TRACING
+            instrumentation_ = other.instrumentation_;
+#endif
+            
+            other.head_ = nullptr;
+            other.tail_ = nullptr;
+            other.size_ = 0;
+            other.node_cache_ = nullptr;
+            other.cached_nodes_ = 0;
+        }
+        return *this;
+    }
+    
+    template<typename U>
+    void push(U&& value) {
+        emplace(std::forward<U>(value));
+    }
+    
+    template<typename... Args>
+    T& emplace(Args&&... args) {
+        check_capacity(1);
+        const std::uint64_t started = trace_start();
+        node_type* new_node = create_node(std::forward<Args>(args)...);
+        link_chain(new_node, new_node, 1);
+        trace_push(started);
+        return new_node->value;
+    }
+    
+    template<typename U>
+    [[nodiscard]] bool try_push(U&& value) {
+        return try_emplace(std::forward<U>(value));
+    }
+    
+    template<typename... Args>
+    [[nodiscard]] bool try_emplace(Args&&... args) {
+        if (full()) return false;
+        
+        try {
+            emplace(std::forward<Args>(args)...);
+        } catch (const std::bad_alloc&) {
+            return false;
+        }
+        return true;
+    }
+    
+    template<typename InputIt>
+    void push_range(InputIt first, InputIt last) {
+        const std::uint64_t started = trace_start();
+        node_type* chain_head = nullptr;
+        node_type* chain_tail = nullptr;
+        std::size_t count = 0;
+        
+        try {
+            for (; first != last; ++first) {
+                check_capacity(count + 1);
+                node_type* node = create_node(*first);
+                if (chain_tail) {
+                    chain_tail->next = node;
+                } else {
+                    chain_head = node;
+                }
+                chain_tail = node;
+                ++count;
+            }
+        } catch (...) {
+            while (chain_head) {
+                node_type* next = chain_head->next;
+                destroy_node(chain_head);
+                chain_head = next;
+            }
+            throw;
+        }
+        
+        link_chain(chain_head, chain_tail, count);
+        trace_push(started);
+    }
+    
+    void pop() {
+        (void)try_pop();
+    }
+    
+    [[nodiscard]] bool try_pop() {
+        node_type* old_head = head_;
+        if (!old_head) return false;
+        
+        const std::uint64_t started = trace_start();
+        head_ = old_head->next;
+        if (!head_) {
+            tail_ = nullptr;
+        }
+        
+        const std::uint64_t enqueued_at = enqueue_time(old_head);
+        destroy_node(old_head);
+        --size_;
+        trace_pop(started, enqueued_at);
+        return true;
+    }
+    
+    [[nodiscard]] bool try_pop(T& out) {
+        if (!head_) return false;
+        
+        out = std::move(head_->value);
+        (void)try_pop();
+        return true;
+    }
+    
+    T pop_value() {
+        T value(std::move(head_->value));
+        pop();
+        return value;
+    }
+    
+    template<typename OutputIt>
+    OutputIt pop_n(std::size_t n, OutputIt out) {
+        for (; head_ && n > 0; --n) {
+            *out = std::move(head_->value);
+            ++out;
+            
+            const std::uint64_t started = trace_start();
+            node_type* next = head_->next;
+            const std::uint64_t enqueued_at = enqueue_time(head_);
+            destroy_node(head_);
+            head_ = next;
+            --size_;
+            trace_pop(started, enqueued_at);
+        }
+        
+        if (!head_) {
+            tail_ = nullptr;
+        }
+        return out;
+    }
+    
+    template<typename Callback>
+    std::size_t drain(Callback&& callback) {
+        std::size_t drained = 0;
+        while (head_) {
+            std::invoke(callback, std::move(head_->value));
+            
+            const std::uint64_t started = trace_start();
+            node_type* next = head_->next;
+            const std::uint64_t enqueued_at = enqueue_time(head_);
+            destroy_node(head_);
+            head_ = next;
+            --size_;
+            ++drained;
+            trace_pop(started, enqueued_at);
+        }
+        tail_ = nullptr;
+        return drained;
+    }
+    
+    T& front() { 
+        return head_->value; 
+    }
+    
+    const T& front() const { 
+        return head_->value; 
+    }
+    
+    T& back() { 
+        return tail_->value; 
+    }
+    
+    const T& back() const { 
+        return tail_->value; 
+    }
+    
+    std::optional<std::reference_wrapper<T>> try_front() {
+        if (!head_) return std::nullopt;
+        return std::ref(head_->value);
+    }
+    
+    std::optional<std::reference_wrapper<const T>> try_front() const {
+        if (!head_) return std::nullopt;
+        return std::cref(head_->value);
+    }
+    
+    std::optional<std::reference_wrapper<T>> try_back() {
+        if (!tail_) return std::nullopt;
+        return std::ref(tail_->value);
+    }
+    
+    std::optional<std::reference_wrapper<const T>> try_back() const {
+        if (!tail_) return std::nullopt;
+        return std::cref(tail_->value);
+    }
+    
+    bool empty() const { 
+        return head_ == nullptr; 
+    }
+    
+    std::size_t size() const { 
+        return size_; 
+    }
+    
+    std::size_t capacity() const { 
+        return capacity_; 
+    }
+    
+    bool full() const { 
+        return size_ >= capacity_; 
+    }
+    
+    void clear() {
+        while (!empty()) {
+            pop();
+        }
+    }
+    
+    std::size_t cached_nodes() const { 
+        return cached_nodes_; 
+    }
+    
+    std::size_t node_cache_limit() const { 
+        return node_cache_limit_; 
+    }
+    
+    void set_node_cache_limit(std::size_t limit) {
+        node_cache_limit_ = limit;
+        trim_node_cache(limit);
+    }
+    
+    // Caches enough nodes for n elements in total, raising the cache limit if needed.
+    void reserve(std::size_t n) {
+        if (n <= size_ + cached_nodes_) return;
+        
+        const std::size_t target = n - size_;
+        node_cache_limit_ = std::max(node_cache_limit_, target);
+        while (cached_nodes_ < target) {
+            cache_node(allocator_.allocate(1));
+        }
+    }
+    
+    void shrink_to_fit() {
+        trim_node_cache(0);
+    }
+    
+    void splice_back(PmrQueue&& other) {
+        if (this == &other || !other.head_) return;
+        check_capacity(other.size_);
+        
+        // Across resources each element is popped only once its copy is in place, so a throw
+        // leaves every element in exactly one of the two queues.
+        if (*get_resource() != *other.get_resource()) {
+            while (other.head_) {
+                emplace(std::move(other.head_->value));
+                other.pop();
+            }
+            return;
+        }
+        
+        link_chain(other.head_, other.tail_, other.size_);
+        other.head_ = nullptr;
+        other.tail_ = nullptr;
+        other.size_ = 0;
+    }
+    
+    PmrQueue split_front(std::size_t n) {
+        PmrQueue front_part(PmrQueueOptions{capacity_, node_cache_limit_}, get_resource());
+        if (n == 0 || !head_) return front_part;
+        
+        if (n >= size_) {
+            front_part.link_chain(head_, tail_, size_);
+            head_ = nullptr;
+            tail_ = nullptr;
+            size_ = 0;
+            return front_part;
+        }
+        
+        node_type* last = head_;
+        for (std::size_t i = 1; i < n; ++i) {
+            last = last->next;
+        }
+        
+        node_type* rest = last->next;
+        last->next = nullptr;
+        front_part.link_chain(head_, last, n);
+        head_ = rest;
+        size_ -= n;
+        return front_part;
+    }
+    
+    std::pmr::memory_resource* get_resource() const {
+        return allocator_.resource();
+    }
+    
+    void set_instrumentation(QueueInstrumentation* instrumentation) {
+#if PMR_QUEUE_TRACING
+        instrumentation_ = instrumentation;
+#else
+        (void)instrumentation;
+#endif
+    }
+    
+    QueueInstrumentation* instrumentation() const {
+#if PMR_QUEUE_TRACING
+        return instrumentation_;
+#else
+        return nullptr;
+#endif
+    }
+    
+    // Forgets every node without returning it; the resource must reclaim them wholesale.
+    void release_all() {
+        static_assert(std::is_trivially_destructible_v<T>, 
+                      "release_all requires trivially destructible elements");
+        head_ = nullptr;
+        tail_ = nullptr;
+        size_ = 0;
+        node_cache_ = nullptr;
+        cached_nodes_ = 0;
+    }
+    
+    iterator begin() { 
+        return iterator(head_); 
+    }
+    
+    iterator end() { 
+        return iterator(nullptr); 
+    }
+    
+    const_iterator begin() const { 
+        return const_iterator(head_); 
+    }
+    
+    const_iterator end() const { 
+        return const_iterator(nullptr); 
+    }
+    
+    const_iterator cbegin() const { 
+        return const_iterator(head_); 
+    }
+    
+    const_iterator cend() const { 
+        return const_iterator(nullptr); 
+    }
+
+private:
+    void check_capacity(std::size_t additional) const {
+        if (additional > capacity_ - std::min(size_, capacity_)) {
+            throw std::length_error("PmrQueue capacity exceeded");
+        }
+    }
+    
+    std::uint64_t trace_start() const {
+#if PMR_QUEUE_TRACING
+        if (instrumentation_) {
+            return queue_trace_now();
+        }
+#endif
+        return 0;
+    }
+    
+    void trace_push([[maybe_unused]] std::uint64_t started) const {
+#if PMR_QUEUE_TRACING
+        if (instrumentation_) {
+            instrumentation_->on_push(queue_trace_now() - started, size_);
+        }
+#endif
+    }
     
-    DynamicMemoryResource(const DynamicMemoryResource&) = delete;
-    DynamicMemoryResource& operator=(const DynamicMemoryResource&) = delete;
+    void trace_pop([[maybe_unused]] std::uint64_t started, 
+                   [[maybe_unused]] std::uint64_t enqueued_at) const {
+#if PMR_QUEUE_TRACING
+        if (instrumentation_) {
+            const std::uint64_t now = queue_trace_now();
+            std::optional<std::uint64_t> residency;
+            if constexpr (timestamped) {
+                residency = now - enqueued_at;
+            }
+            instrumentation_->on_pop(now - started, size_, residency);
+        }
+#endif
+    }
     
-    ~DynamicMemoryResource() override {
-        for (const auto& block : allocated_blocks_) {
-            upstream_->deallocate(block.ptr, block.size);
+    static std::uint64_t enqueue_time([[maybe_unused]] const node_type* node) {
+        if constexpr (timestamped) {
+            return node->enqueued_at;
+        } else {
+            return 0;
         }
     }
-
-protected:
-    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
-        void* ptr = upstream_->allocate(bytes, alignment);
+    
+    template<typename... Args>
+    node_type* create_node(Args&&... args) {
+        node_type* node = acquire_node();
         try {
-            allocated_blocks_.emplace_back(ptr, bytes);
+            std::construct_at(node, std::allocator_arg, allocator_, std::forward<Args>(args)...);
         } catch (...) {
-            upstream_->deallocate(ptr, bytes, alignment);
+            release_node(node);
             throw;
         }
-        return ptr;
+        return node;
     }
     
-    void do_deallocate(void* ptr, std::size_t bytes, 
-                      std::size_t alignment) override {
-        auto it = std::find_if(allocated_blocks_.begin(), allocated_blocks_.end(),
-                              [ptr](const BlockInfo& block) {
-                                  return block.ptr == ptr;
-                              });
-        
-        if (it != allocated_blocks_.end()) {
-            upstream_->deallocate(ptr, bytes, alignment);
-            allocated_blocks_.erase(it);
-        }
+    void destroy_node(node_type* node) {
+        std::destroy_at(node);
+        release_node(node);
     }
     
-    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
-        return this == &other;
+    node_type* acquire_node() {
+        if (!node_cache_) {
+            return allocator_.allocate(1);
+        }
+        
+        CachedNode* cached = node_cache_;
+        node_cache_ = cached->next;
+        --cached_nodes_;
+        std::destroy_at(cached);
+        return reinterpret_cast<node_type*>(cached);
     }
-};
-
-template<typename T>
-struct QueueNode {
-    T value;
-    QueueNode* next;
     
-    template<typename... Args>
-    QueueNode(Args&&... args) 
-        : value(std::forward<Args>(args)...), next(nullptr) {}
-};
-
-template<typename T>
-class QueueIterator {
-private:
-    QueueNode<T>* current_;
-
-public:
-    using iterator_category = std::forward_iterator_tag;
-    using value_type = T;
-    using difference_type = std::ptrdiff_t;
-    using pointer = T*;
-    using reference = T&;
-
-    explicit QueueIterator(QueueNode<T>* node = nullptr) : current_(node) {}
-
-    QueueIterator& operator++() {
-        if (current_) {
-            current_ = current_->next;
+    void release_node(node_type* node) {
+        if (cached_nodes_ < node_cache_limit_) {
+            cache_node(node);
+        } else {
+            allocator_.deallocate(node, 1);
         }
-        return *this;
-    }
-
-    QueueIterator operator++(int) {
-        QueueIterator temp = *this;
-        ++(*this);
-        return temp;
-    }
-
-    reference operator*() const { 
-        return current_->value; 
     }
     
-    pointer operator->() const { 
-        return &current_->value; 
+    void cache_node(node_type* node) {
+        node_cache_ = std::construct_at(reinterpret_cast<CachedNode*>(node), 
+                                        CachedNode{node_cache_});
+        ++cached_nodes_;
     }
-
-    bool operator==(const QueueIterator& other) const {
-        return current_ == other.current_;
+    
+    void trim_node_cache(std::size_t limit) {
+        while (cached_nodes_ > limit) {
+            allocator_.deallocate(acquire_node(), 1);
+        }
     }
     
-    bool operator!=(const QueueIterator& other) const {
-        return !(*this == other);
+    void link_chain(node_type* first, node_type* last, std::size_t count) {
+        if (!first) return;
+        
+        if (tail_) {
+            tail_->next = first;
+        } else {
+            head_ = first;
+        }
+        tail_ = last;
+        size_ += count;
     }
 };
 
-template<typename T>
-class PmrQueue {
+template<typename T, std::size_t ChunkCapacity>
+class PmrQueue<T, ChunkedStorage<ChunkCapacity>> {
 private:
-    using allocator_type = std::pmr::polymorphic_allocator<QueueNode<T>>;
+    using chunk_type = QueueChunk<T, ChunkCapacity>;
+    using allocator_type = std::pmr::polymorphic_allocator<chunk_type>;
     
-    QueueNode<T>* head_;
-    QueueNode<T>* tail_;
+    chunk_type* head_;
+    chunk_type* tail_;
+    chunk_type* spare_;
+    std::size_t head_index_;
     allocator_type allocator_;
     std::size_t size_;
+    std::size_t capacity_;
+#if PMR_QUEUE_TRACING
+    QueueInstrumentation* instrumentation_ = nullptr;
+#endif
 
 public:
-    using iterator = QueueIterator<T>;
-    using const_iterator = QueueIterator<const T>;
+    using iterator = ChunkedQueueIterator<T, chunk_type>;
+    using const_iterator = ChunkedQueueIterator<const T, chunk_type>;
+    using segment_iterator = ChunkedSegmentIterator<T, chunk_type>;
+    using const_segment_iterator = ChunkedSegmentIterator<const T, chunk_type>;
+    
+    static constexpr std::size_t chunk_capacity = ChunkCapacity;
+    static constexpr bool tracing_enabled = PMR_QUEUE_TRACING != 0;
 
     explicit PmrQueue(std::pmr::memory_resource* mr = 
                      std::pmr::get_default_resource()) 
-        : head_(nullptr), tail_(nullptr), allocator_(mr), size_(0) {}
+        : PmrQueue(PmrQueueOptions{}, mr) {}
+    
+    explicit PmrQueue(const PmrQueueOptions& options,
+                     std::pmr::memory_resource* mr = 
+                     std::pmr::get_default_resource()) 
+        : head_(nullptr), tail_(nullptr), spare_(nullptr), head_index_(0),
+          allocator_(mr), size_(0), capacity_(options.capacity) {}
     
     ~PmrQueue() {
         clear();
+        release_spare();
     }
     
     PmrQueue(const PmrQueue&) = delete;
     PmrQueue& operator=(const PmrQueue&) = delete;
     
     PmrQueue(PmrQueue&& other) noexcept 
-        : head_(other.head_), tail_(other.tail_), 
-          allocator_(other.allocator_), size_(other.size_) {
+        : head_(other.head_), tail_(other.tail_), spare_(other.spare_),
+          head_index_(other.head_index_), allocator_(other.allocator_), 
+          size_(other.size_), capacity_(other.capacity_) {
+#if PMR_QUEUE_TRACING
+        instrumentation_ = other.instrumentation_;
+#endif
         other.head_ = nullptr;
         other.tail_ = nullptr;
+        other.spare_ = nullptr;
+        other.head_index_ = 0;
         other.size_ = 0;
     }
     
     PmrQueue& operator=(PmrQueue&& other) noexcept {
         if (this != &other) {
             clear();
+            release_spare();
             head_ = other.head_;
             tail_ = other.tail_;
-            allocator_ = other.allocator_;
+            spare_ = other.spare_;
+            head_index_ = other.head_index_;
+            std::destroy_at(&allocator_);
+            std::construct_at(&allocator_, other.allocator_);
             size_ = other.size_;
+            capacity_ = other.capacity_;
+#if PMR_QUEUE_TRACING
+            instrumentation_ = other.instrumentation_;
+#endif
             
             other.head_ = nullptr;
             other.tail_ = nullptr;
+            other.spare_ = nullptr;
+            other.head_index_ = 0;
             other.size_ = 0;
         }
         return *this;
@@ -164,44 +1387,186 @@ public:
     
     template<typename U>
     void push(U&& value) {
-        QueueNode<T>* new_node = allocator_.allocate(1);
+        emplace(std::forward<U>(value));
+    }
+    
+    template<typename... Args>
+    T& emplace(Args&&... args) {
+        check_capacity(1);
+        const std::uint64_t started = trace_start();
+        chunk_type* chunk = writable_chunk();
+        T* slot = chunk->slot(chunk->end);
         try {
-            allocator_.construct(new_node, std::forward<U>(value));
+            std::uninitialized_construct_using_allocator(slot, allocator_, 
+                                                        std::forward<Args>(args)...);
         } catch (...) {
-            allocator_.deallocate(new_node, 1);
+            commit_chunk(chunk);
             throw;
         }
+        ++chunk->end;
+        ++size_;
+        commit_chunk(chunk);
+        trace_push(started);
+        return *slot;
+    }
+    
+    template<typename U>
+    [[nodiscard]] bool try_push(U&& value) {
+        return try_emplace(std::forward<U>(value));
+    }
+    
+    template<typename... Args>
+    [[nodiscard]] bool try_emplace(Args&&... args) {
+        if (full()) return false;
         
-        if (tail_) {
-            tail_->next = new_node;
-        } else {
-            head_ = new_node;
+        try {
+            emplace(std::forward<Args>(args)...);
+        } catch (const std::bad_alloc&) {
+            return false;
         }
-        tail_ = new_node;
-        ++size_;
+        return true;
+    }
+    
+    template<typename InputIt>
+    void push_range(InputIt first, InputIt last) {
+        if constexpr (std::forward_iterator<InputIt>) {
+            check_capacity(static_cast<std::size_t>(std::distance(first, last)));
+        }
+        
+        const std::uint64_t started = trace_start();
+        chunk_type* const old_tail = tail_;
+        const std::size_t old_end = old_tail ? old_tail->end : 0;
+        const std::size_t old_size = size_;
+        try {
+            while (first != last) {
+                chunk_type* chunk = writable_chunk();
+                try {
+                    for (; first != last && chunk->end < ChunkCapacity; ++first) {
+                        check_capacity(1);
+                        std::uninitialized_construct_using_allocator(chunk->slot(chunk->end), 
+                                                                    allocator_, *first);
+                        ++chunk->end;
+                        ++size_;
+                    }
+                } catch (...) {
+                    commit_chunk(chunk);
+                    throw;
+                }
+                commit_chunk(chunk);
+            }
+        } catch (...) {
+            truncate(old_tail, old_end, old_size);
+            throw;
+        }
+        trace_push(started);
     }
     
     void pop() {
-        if (!head_) return;
+        (void)try_pop();
+    }
+    
+    [[nodiscard]] bool try_pop() {
+        if (!head_) return false;
         
-        QueueNode<T>* old_head = head_;
-        head_ = head_->next;
+        const std::uint64_t started = trace_start();
+        std::destroy_at(head_->slot(head_index_));
+        --size_;
         
-        if (!head_) {
-            tail_ = nullptr;
+        if (++head_index_ == head_->end) {
+            retire_head();
         }
+        trace_pop(started);
+        return true;
+    }
+    
+    [[nodiscard]] bool try_pop(T& out) {
+        if (!head_) return false;
         
-        allocator_.destroy(old_head);
-        allocator_.deallocate(old_head, 1);
-        --size_;
+        out = std::move(*head_->slot(head_index_));
+        (void)try_pop();
+        return true;
+    }
+    
+    T pop_value() {
+        T value(std::move(*head_->slot(head_index_)));
+        pop();
+        return value;
+    }
+    
+    template<typename OutputIt>
+    OutputIt pop_n(std::size_t n, OutputIt out) {
+        while (head_ && n > 0) {
+            const std::size_t stop = std::min(head_->end, head_index_ + n);
+            for (; head_index_ < stop; ++head_index_) {
+                T* slot = head_->slot(head_index_);
+                *out = std::move(*slot);
+                ++out;
+                const std::uint64_t started = trace_start();
+                std::destroy_at(slot);
+                --size_;
+                --n;
+                trace_pop(started);
+            }
+            
+            if (head_index_ == head_->end) {
+                retire_head();
+            }
+        }
+        return out;
+    }
+    
+    template<typename Callback>
+    std::size_t drain(Callback&& callback) {
+        std::size_t drained = 0;
+        while (head_) {
+            for (; head_index_ < head_->end; ++head_index_) {
+                T* slot = head_->slot(head_index_);
+                std::invoke(callback, std::move(*slot));
+                const std::uint64_t started = trace_start();
+                std::destroy_at(slot);
+                --size_;
+                ++drained;
+                trace_pop(started);
+            }
+            retire_head();
+        }
+        return drained;
     }
     
     T& front() { 
-        return head_->value; 
+        return *head_->slot(head_index_); 
     }
     
     const T& front() const { 
-        return head_->value; 
+        return *head_->slot(head_index_); 
+    }
+    
+    T& back() { 
+        return *tail_->slot(tail_->end - 1); 
+    }
+    
+    const T& back() const { 
+        return *tail_->slot(tail_->end - 1); 
+    }
+    
+    std::optional<std::reference_wrapper<T>> try_front() {
+        if (!head_) return std::nullopt;
+        return std::ref(front());
+    }
+    
+    std::optional<std::reference_wrapper<const T>> try_front() const {
+        if (!head_) return std::nullopt;
+        return std::cref(front());
+    }
+    
+    std::optional<std::reference_wrapper<T>> try_back() {
+        if (!tail_) return std::nullopt;
+        return std::ref(back());
+    }
+    
+    std::optional<std::reference_wrapper<const T>> try_back() const {
+        if (!tail_) return std::nullopt;
+        return std::cref(back());
     }
     
     bool empty() const { 
@@ -212,14 +1577,59 @@ public:
         return size_; 
     }
     
+    std::size_t capacity() const { 
+        return capacity_; 
+    }
+    
+    bool full() const { 
+        return size_ >= capacity_; 
+    }
+    
     void clear() {
-        while (!empty()) {
-            pop();
+        while (head_) {
+            chunk_type* chunk = head_;
+            if constexpr (!std::is_trivially_destructible_v<T>) {
+                for (std::size_t i = head_index_; i < chunk->end; ++i) {
+                    std::destroy_at(chunk->slot(i));
+                }
+            }
+            head_ = chunk->next;
+            head_index_ = 0;
+            release_chunk(chunk);
         }
+        tail_ = nullptr;
+        size_ = 0;
+    }
+    
+    void set_instrumentation(QueueInstrumentation* instrumentation) {
+#if PMR_QUEUE_TRACING
+        instrumentation_ = instrumentation;
+#else
+        (void)instrumentation;
+#endif
+    }
+    
+    QueueInstrumentation* instrumentation() const {
+#if PMR_QUEUE_TRACING
+        return instrumentation_;
+#else
+        return nullptr;
+#endif
+    }
+    
+    // Forgets every chunk without returning it; the resource must reclaim them wholesale.
+    void release_all() {
+        static_assert(std::is_trivially_destructible_v<T>, 
+                      "release_all requires trivially destructible elements");
+        head_ = nullptr;
+        tail_ = nullptr;
+        spare_ = nullptr;
+        head_index_ = 0;
+        size_ = 0;
     }
     
     iterator begin() { 
-        return iterator(head_); 
+        return iterator(head_, head_index_); 
     }
     
     iterator end() { 
@@ -227,7 +1637,7 @@ public:
     }
     
     const_iterator begin() const { 
-        return const_iterator(head_); 
+        return const_iterator(head_, head_index_); 
     }
     
     const_iterator end() const { 
@@ -235,14 +1645,262 @@ public:
     }
     
     const_iterator cbegin() const { 
-        return const_iterator(head_); 
+        return const_iterator(head_, head_index_); 
     }
     
     const_iterator cend() const { 
         return const_iterator(nullptr); 
     }
+    
+    // Each segment is the contiguous run of live elements in one chunk, front to back.
+    std::ranges::subrange<segment_iterator> segments() {
+        return {segment_iterator(head_, head_index_), segment_iterator()};
+    }
+    
+    std::ranges::subrange<const_segment_iterator> segments() const {
+        return {const_segment_iterator(head_, head_index_), const_segment_iterator()};
+    }
+    
+    template<typename Callback>
+    void for_each_segment(Callback&& callback) {
+        for (std::span<T> segment : segments()) {
+            std::invoke(callback, segment);
+        }
+    }
+    
+    template<typename Callback>
+    void for_each_segment(Callback&& callback) const {
+        for (std::span<const T> segment : segments()) {
+            std::invoke(callback, segment);
+        }
+    }
+    
+    // Segments are reduced with unseq, so op must be associative and commutative.
+    template<typename U, typename BinaryOp = std::plus<>>
+    U reduce(U init, BinaryOp op = {}) const {
+        for_each_segment([&](std::span<const T> segment) {
+            init = std::reduce(std::execution::unseq, segment.begin(), segment.end(), 
+                               std::move(init), op);
+        });
+        return init;
+    }
+    
+    template<typename U, typename BinaryOp, typename UnaryOp>
+    U transform_reduce(U init, BinaryOp reduce_op, UnaryOp transform_op) const {
+        for_each_segment([&](std::span<const T> segment) {
+            init = std::transform_reduce(std::execution::unseq, segment.begin(), segment.end(), 
+                                         std::move(init), reduce_op, transform_op);
+        });
+        return init;
+    }
+    
+    // A random-access table of segments, so the chunk list can be split across threads.
+    std::pmr::vector<std::span<T>> segment_table() {
+        return segment_table(get_resource());
+    }
+    
+    std::pmr::vector<std::span<const T>> segment_table() const {
+        return segment_table(get_resource());
+    }
+    
+    std::pmr::vector<std::span<T>> segment_table(std::pmr::memory_resource* mr) {
+        std::pmr::vector<std::span<T>> table(mr);
+        table.reserve(size_ / ChunkCapacity + 2);
+        auto view = segments();
+        table.assign(view.begin(), view.end());
+        return table;
+    }
+    
+    std::pmr::vector<std::span<const T>> segment_table(std::pmr::memory_resource* mr) const {
+        std::pmr::vector<std::span<const T>> table(mr);
+        table.reserve(size_ / ChunkCapacity + 2);
+        auto view = segments();
+        table.assign(view.begin(), view.end());
+        return table;
+    }
+    
+    template<typename ExecutionPolicy, typename Callback>
+        requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+    void for_each(ExecutionPolicy&& policy, Callback callback) {
+        auto table = segment_table(std::pmr::new_delete_resource());
+        std::for_each(policy, table.begin(), table.end(),
+                      [&callback](std::span<T> segment) {
+                          std::for_each(segment.begin(), segment.end(), callback);
+                      });
+    }
+    
+    template<typename ExecutionPolicy, typename Callback>
+        requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+    void for_each(ExecutionPolicy&& policy, Callback callback) const {
+        auto table = segment_table(std::pmr::new_delete_resource());
+        std::for_each(policy, table.begin(), table.end(),
+                      [&callback](std::span<const T> segment) {
+                          std::for_each(segment.begin(), segment.end(), callback);
+                      });
+    }
+    
+    // Destructors run under the policy; chunks are still returned to the resource serially.
+    // The segment table comes from the heap, never from the queue's budgeted resource, and
+    // the clear falls back to the serial path if even that allocation fails.
+    template<typename ExecutionPolicy>
+        requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+    void clear(ExecutionPolicy&& policy) {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            std::optional<std::pmr::vector<std::span<T>>> table;
+            try {
+                table.emplace(segment_table(std::pmr::new_delete_resource()));
+            } catch (const std::bad_alloc&) {
+                clear();
+                return;
+            }
+            std::for_each(policy, table->begin(), table->end(),
+                          [](std::span<T> segment) {
+                              std::destroy(segment.begin(), segment.end());
+                          });
+        }
+        
+        while (head_) {
+            chunk_type* chunk = head_;
+            head_ = chunk->next;
+            release_chunk(chunk);
+        }
+        head_index_ = 0;
+        tail_ = nullptr;
+        size_ = 0;
+    }
+    
+    std::pmr::memory_resource* get_resource() const {
+        return allocator_.resource();
+    }
+
+private:
+    void check_capacity(std::size_t additional) const {
+        if (additional > capacity_ - std::min(size_, capacity_)) {
+            throw std::length_error("PmrQueue capacity exceeded");
+        }
+    }
+    
+    std::uint64_t trace_start() const {
+#if PMR_QUEUE_TRACING
+        if (instrumentation_) {
+            return queue_trace_now();
+        }
+#endif
+        return 0;
+    }
+    
+    void trace_push([[maybe_unused]] std::uint64_t started) const {
+#if PMR_QUEUE_TRACING
+        if (instrumentation_) {
+            instrumentation_->on_push(queue_trace_now() - started, size_);
+        }
+#endif
+    }
+    
+    // Chunk slots carry no enqueue stamp, so residency is never reported.
+    void trace_pop([[maybe_unused]] std::uint64_t started) const {
+#if PMR_QUEUE_TRACING
+        if (instrumentation_) {
+            instrumentation_->on_pop(queue_trace_now() - started, size_, std::nullopt);
+        }
+#endif
+    }
+    
+    chunk_type* writable_chunk() {
+        if (tail_ && tail_->end < ChunkCapacity) {
+            return tail_;
+        }
+        return acquire_chunk();
+    }
+    
+    void commit_chunk(chunk_type* chunk) {
+        if (chunk == tail_) return;
+        
+        if (chunk->end == 0) {
+            release_chunk(chunk);
+            return;
+        }
+        
+        if (tail_) {
+            tail_->next = chunk;
+        } else {
+            head_ = chunk;
+            head_index_ = 0;
+        }
+        tail_ = chunk;
+    }
+    
+    // Destroys everything pushed after the given tail position, undoing a partial push_range.
+    void truncate(chunk_type* tail, std::size_t end, std::size_t size) {
+        chunk_type* chunk = tail ? tail : head_;
+        std::size_t index = tail ? end : head_index_;
+        while (chunk) {
+            for (std::size_t i = index; i < chunk->end; ++i) {
+                std::destroy_at(chunk->slot(i));
+            }
+            
+            chunk_type* next = chunk->next;
+            if (chunk == tail) {
+                chunk->end = end;
+                chunk->next = nullptr;
+            } else {
+                release_chunk(chunk);
+            }
+            chunk = next;
+            index = 0;
+        }
+        
+        tail_ = tail;
+        if (!tail) {
+            head_ = nullptr;
+            head_index_ = 0;
+        }
+        size_ = size;
+    }
+    
+    void retire_head() {
+        chunk_type* old_head = head_;
+        head_ = head_->next;
+        head_index_ = 0;
+        
+        if (!head_) {
+            tail_ = nullptr;
+        }
+        release_chunk(old_head);
+    }
+    
+    chunk_type* acquire_chunk() {
+        chunk_type* chunk = spare_;
+        if (chunk) {
+            spare_ = nullptr;
+        } else {
+            chunk = allocator_.allocate(1);
+        }
+        return std::construct_at(chunk);
+    }
+    
+    void release_chunk(chunk_type* chunk) {
+        if (!spare_) {
+            spare_ = chunk;
+        } else {
+            allocator_.deallocate(chunk, 1);
+        }
+    }
+    
+    void release_spare() {
+        if (spare_) {
+            allocator_.deallocate(spare_, 1);
+            spare_ = nullptr;
+        }
+    }
 };
 
+template<typename T, std::size_t ChunkCapacity = 64>
+using ChunkedPmrQueue = PmrQueue<T, ChunkedStorage<ChunkCapacity>>;
+
+template<typename T>
+using CacheAlignedPmrQueue = PmrQueue<T, AlignedNodeStorage<cache_line_size>>;
+
 struct ComplexType {
     int id;
     double value;
@@ -261,3 +1919,40 @@ struct ComplexType {
         return id == other.id && value == other.value && name == other.name;
     }
 };
+
+struct PmrComplexType {
+    using allocator_type = std::pmr::polymorphic_allocator<char>;
+    
+    int id;
+    double value;
+    std::pmr::string name;
+    
+    PmrComplexType(int i, double v, std::string_view n, 
+                   const allocator_type& alloc = {}) 
+        : id(i), value(v), name(n, alloc) {}
+    
+    PmrComplexType(const PmrComplexType& other, const allocator_type& alloc = {}) 
+        : id(other.id), value(other.value), name(other.name, alloc) {}
+    
+    PmrComplexType(PmrComplexType&& other) noexcept = default;
+    
+    PmrComplexType(PmrComplexType&& other, const allocator_type& alloc) 
+        : id(other.id), value(other.value), name(std::move(other.name), alloc) {}
+    
+    PmrComplexType& operator=(const PmrComplexType&) = default;
+    PmrComplexType& operator=(PmrComplexType&&) = default;
+    
+    allocator_type get_allocator() const { 
+        return name.get_allocator(); 
+    }
+    
+    friend std::ostream& operator<<(std::ostream& os, const PmrComplexType& ct) {
+        os << "PmrComplexType{id=" << ct.id << ", value=" << ct.value 
+           << ", name=\"" << ct.name << "\"}";
+        return os;
+    }
+    
+    bool operator==(const PmrComplexType& other) const {
+        return id == other.id && value == other.value && name == other.name;
+    }
+};
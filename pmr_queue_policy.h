@@ -0,0 +1,312 @@
+#pragma once
+#include "pmr_queue.h"
+#include "pmr_spsc_queue.h"
+#include "pmr_mpmc_queue.h"
+
+struct SingleThreaded {};
+struct SingleProducerSingleConsumer {};
+struct MultiProducerMultiConsumer {};
+
+struct PmrAllocation {};
+
+template<typename Allocator>
+struct StaticAllocation {};
+
+template<typename Storage = NodeStorage, 
+         typename Concurrency = SingleThreaded,
+         typename Allocation = PmrAllocation, 
+         bool Stats = false>
+struct QueuePolicy {
+    using storage = Storage;
+    using concurrency = Concurrency;
+    using allocation = Allocation;
+    static constexpr bool stats = Stats;
+};
+
+struct QueueOpStats {
+    std::size_t size = 0;
+    std::size_t pushes = 0;
+    std::size_t pops = 0;
+    std::size_t high_water = 0;
+};
+
+namespace policy_detail {
+
+struct NoStats {};
+struct NoResource {};
+struct NoAllocator {};
+
+template<typename Storage>
+struct is_chunked : std::false_type {};
+
+template<std::size_t N>
+struct is_chunked<ChunkedStorage<N>> : std::true_type {};
+
+template<typename Allocation>
+struct static_allocator {
+    using type = NoAllocator;
+};
+
+template<typename Allocator>
+struct static_allocator<StaticAllocation<Allocator>> {
+    using type = Allocator;
+};
+
+}
+
+// Serves a PmrQueue from a standard allocator; requests above max_align_t are refused.
+// Every block still goes through a virtual do_allocate call.
+template<typename Allocator>
+class AllocatorResource : public std::pmr::memory_resource {
+private:
+    struct alignas(std::max_align_t) Block {
+        std::byte bytes[alignof(std::max_align_t)];
+    };
+    
+    using block_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Block>;
+    using block_traits = std::allocator_traits<block_allocator>;
+    
+    [[no_unique_address]] block_allocator allocator_;
+
+public:
+    explicit AllocatorResource(const Allocator& allocator = Allocator()) 
+        : allocator_(allocator) {}
+    
+    Allocator get_allocator() const { 
+        return Allocator(allocator_); 
+    }
+
+protected:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        if (alignment > alignof(Block)) {
+            throw std::bad_alloc();
+        }
+        return block_traits::allocate(allocator_, blocks(bytes));
+    }
+    
+    void do_deallocate(void* ptr, std::size_t bytes, std::size_t) override {
+        block_traits::deallocate(allocator_, static_cast<Block*>(ptr), blocks(bytes));
+    }
+    
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+private:
+    static std::size_t blocks(std::size_t bytes) {
+        return (bytes + sizeof(Block) - 1) / sizeof(Block);
+    }
+};
+
+// A thin wrapper that picks a PmrQueue's storage layout, allocator source and op statistics
+// at compile time. Only the statistics compile out entirely; the wrapped PmrQueue keeps its
+// size, capacity, node cache and tracing state, and allocates through polymorphic_allocator.
+template<typename T, typename Policy>
+class PolicyQueue {
+private:
+    static constexpr bool chunked = policy_detail::is_chunked<typename Policy::storage>::value;
+    static constexpr bool pmr = std::is_same_v<typename Policy::allocation, PmrAllocation>;
+    static constexpr bool stats_enabled = Policy::stats;
+    
+    using queue_type = PmrQueue<T, typename Policy::storage>;
+    using static_allocator_type = typename policy_detail::static_allocator<
+        typename Policy::allocation>::type;
+    using resource_type = std::conditional_t<pmr, policy_detail::NoResource, 
+                                             AllocatorResource<static_allocator_type>>;
+    using stats_type = std::conditional_t<stats_enabled, QueueOpStats, policy_detail::NoStats>;
+    
+    [[no_unique_address]] resource_type resource_;
+    queue_type queue_;
+    [[no_unique_address]] stats_type stats_;
+
+public:
+    using iterator = typename queue_type::iterator;
+    using const_iterator = typename queue_type::const_iterator;
+    using allocator_type = std::conditional_t<pmr, std::pmr::polymorphic_allocator<T>, 
+                                              static_allocator_type>;
+
+    explicit PolicyQueue(std::pmr::memory_resource* mr = 
+                        std::pmr::get_default_resource()) requires pmr
+        : queue_(mr) {}
+    
+    explicit PolicyQueue(const PmrQueueOptions& options, 
+                        std::pmr::memory_resource* mr = 
+                        std::pmr::get_default_resource()) requires pmr
+        : queue_(options, mr) {}
+    
+    PolicyQueue() requires (!pmr) 
+        : resource_(), queue_(&resource_) {}
+    
+    explicit PolicyQueue(const static_allocator_type& allocator) requires (!pmr) 
+        : resource_(allocator), queue_(&resource_) {}
+    
+    explicit PolicyQueue(const PmrQueueOptions& options, 
+                        const static_allocator_type& allocator = static_allocator_type()) 
+        requires (!pmr) 
+        : resource_(allocator), queue_(options, &resource_) {}
+    
+    // The queue refers to resource_, so a PolicyQueue stays where it was built.
+    PolicyQueue(const PolicyQueue&) = delete;
+    PolicyQueue& operator=(const PolicyQueue&) = delete;
+    
+    template<typename U>
+    void push(U&& value) {
+        emplace(std::forward<U>(value));
+    }
+    
+    template<typename... Args>
+    T& emplace(Args&&... args) {
+        T& value = queue_.emplace(std::forward<Args>(args)...);
+        record_push();
+        return value;
+    }
+    
+    template<typename U>
+    [[nodiscard]] bool try_push(U&& value) {
+        return try_emplace(std::forward<U>(value));
+    }
+    
+    template<typename... Args>
+    [[nodiscard]] bool try_emplace(Args&&... args) {
+        if (!queue_.try_emplace(std::forward<Args>(args)...)) return false;
+        
+        record_push();
+        return true;
+    }
+    
+    void pop() {
+        (void)try_pop();
+    }
+    
+    [[nodiscard]] bool try_pop() {
+        if (!queue_.try_pop()) return false;
+        
+        record_pops(1);
+        return true;
+    }
+    
+    [[nodiscard]] bool try_pop(T& out) {
+        if (!queue_.try_pop(out)) return false;
+        
+        record_pops(1);
+        return true;
+    }
+    
+    T& front() {
+        return queue_.front();
+    }
+    
+    const T& front() const {
+        return queue_.front();
+    }
+    
+    std::optional<std::reference_wrapper<T>> try_front() {
+        return queue_.try_front();
+    }
+    
+    std::optional<std::reference_wrapper<const T>> try_front() const {
+        return queue_.try_front();
+    }
+    
+    bool empty() const { 
+        return queue_.empty(); 
+    }
+    
+    std::size_t size() const { 
+        return queue_.size(); 
+    }
+    
+    std::size_t capacity() const { 
+        return queue_.capacity(); 
+    }
+    
+    bool full() const { 
+        return queue_.full(); 
+    }
+    
+    const QueueOpStats& stats() const requires stats_enabled { 
+        return stats_; 
+    }
+    
+    void clear() {
+        record_pops(queue_.size());
+        queue_.clear();
+    }
+    
+    void reserve(std::size_t n) requires (!chunked) {
+        queue_.reserve(n);
+    }
+    
+    void shrink_to_fit() requires (!chunked) {
+        queue_.shrink_to_fit();
+    }
+    
+    allocator_type get_allocator() const { 
+        if constexpr (pmr) {
+            return allocator_type(queue_.get_resource());
+        } else {
+            return resource_.get_allocator();
+        }
+    }
+    
+    iterator begin() { 
+        return queue_.begin(); 
+    }
+    
+    iterator end() { 
+        return queue_.end(); 
+    }
+    
+    const_iterator begin() const { 
+        return queue_.begin(); 
+    }
+    
+    const_iterator end() const { 
+        return queue_.end(); 
+    }
+
+private:
+    void record_push() {
+        if constexpr (stats_enabled) {
+            ++stats_.pushes;
+            stats_.high_water = std::max(stats_.high_water, ++stats_.size);
+        }
+    }
+    
+    void record_pops([[maybe_unused]] std::size_t count) {
+        if constexpr (stats_enabled) {
+            stats_.pops += count;
+            stats_.size -= count;
+        }
+    }
+};
+
+template<typename T, typename Policy>
+struct queue_selector {
+    using type = PolicyQueue<T, Policy>;
+};
+
+// The concurrent queues keep their own ring or node layout, always allocate through pmr
+// and keep no op statistics.
+template<typename T, typename Storage, typename Allocation, bool Stats>
+struct queue_selector<T, QueuePolicy<Storage, SingleProducerSingleConsumer, Allocation, Stats>> {
+    static_assert(std::is_same_v<Allocation, PmrAllocation>, 
+                  "the SPSC queue allocates through a memory resource");
+    static_assert(std::is_same_v<Storage, NodeStorage>, 
+                  "the SPSC queue uses its own ring layout; leave Storage as NodeStorage");
+    static_assert(!Stats, "the SPSC queue does not keep op statistics");
+    using type = SpscPmrQueue<T>;
+};
+
+template<typename T, typename Storage, typename Allocation, bool Stats>
+struct queue_selector<T, QueuePolicy<Storage, MultiProducerMultiConsumer, Allocation, Stats>> {
+    static_assert(std::is_same_v<Allocation, PmrAllocation>, 
+                  "the MPMC queue allocates through a memory resource");
+    static_assert(std::is_same_v<Storage, NodeStorage>, 
+                  "the MPMC queue is node based");
+    static_assert(!Stats, "the MPMC queue does not keep op statistics");
+    using type = MpmcPmrQueue<T>;
+};
+
+template<typename T, typename Policy = QueuePolicy<>>
+using ConfiguredQueue = typename queue_selector<T, Policy>::type;
@@ -0,0 +1,252 @@
+#pragma once
+#include "pmr_queue.h"
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <string>
+#include <system_error>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+struct QueueSnapshotHeader {
+    static constexpr std::uint64_t expected_magic = 0x504d525155455545ULL;
+    static constexpr std::uint32_t current_version = 1;
+    
+    std::uint64_t magic;
+    std::uint32_t version;
+    std::uint32_t element_size;
+    std::uint64_t element_alignment;
+    std::uint64_t count;
+};
+
+static_assert(sizeof(QueueSnapshotHeader) == 32, "snapshot header layout changed");
+
+namespace snapshot_detail {
+
+class FileDescriptor {
+private:
+    int fd_;
+
+public:
+    explicit FileDescriptor(int fd) : fd_(fd) {}
+    
+    ~FileDescriptor() {
+        if (fd_ >= 0) {
+            ::close(fd_);
+        }
+    }
+    
+    FileDescriptor(const FileDescriptor&) = delete;
+    FileDescriptor& operator=(const FileDescriptor&) = delete;
+    
+    int get() const { 
+        return fd_; 
+    }
+    
+    void close() {
+        const int fd = fd_;
+        fd_ = -1;
+        if (::close(fd) != 0) {
+            throw std::system_error(errno, std::generic_category(), "close");
+        }
+    }
+};
+
+class MappedFile {
+private:
+    void* data_;
+    std::size_t size_;
+
+public:
+    MappedFile(int fd, std::size_t size) : data_(nullptr), size_(size) {
+        if (size_ == 0) return;
+        
+        data_ = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data_ == MAP_FAILED) {
+            throw std::system_error(errno, std::generic_category(), "mmap");
+        }
+        ::madvise(data_, size_, MADV_SEQUENTIAL);
+    }
+    
+    ~MappedFile() {
+        if (data_) {
+            ::munmap(data_, size_);
+        }
+    }
+    
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    
+    const std::byte* data() const { 
+        return static_cast<const std::byte*>(data_); 
+    }
+    
+    std::size_t size() const { 
+        return size_; 
+    }
+};
+
+// writev may stop early, so the iovec window is advanced past whatever was written.
+inline void write_all(int fd, std::vector<iovec>& buffers) {
+    std::size_t first = 0;
+    while (first < buffers.size()) {
+        const int batch = static_cast<int>(std::min<std::size_t>(buffers.size() - first, IOV_MAX));
+        const ssize_t written = ::writev(fd, buffers.data() + first, batch);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            throw std::system_error(errno, std::generic_category(), "writev");
+        }
+        
+        std::size_t remaining = static_cast<std::size_t>(written);
+        while (first < buffers.size() && remaining >= buffers[first].iov_len) {
+            remaining -= buffers[first].iov_len;
+            ++first;
+        }
+        if (remaining > 0) {
+            buffers[first].iov_base = static_cast<std::byte*>(buffers[first].iov_base) + remaining;
+            buffers[first].iov_len -= remaining;
+        }
+    }
+}
+
+// Unlinks a temporary file unless it was renamed into place.
+class TemporaryFile {
+private:
+    std::string path_;
+    bool committed_;
+
+public:
+    explicit TemporaryFile(std::string path) : path_(std::move(path)), committed_(false) {}
+    
+    ~TemporaryFile() {
+        if (!committed_) {
+            ::unlink(path_.c_str());
+        }
+    }
+    
+    TemporaryFile(const TemporaryFile&) = delete;
+    TemporaryFile& operator=(const TemporaryFile&) = delete;
+    
+    const std::string& path() const { 
+        return path_; 
+    }
+    
+    void commit_to(const std::string& target) {
+        if (::rename(path_.c_str(), target.c_str()) != 0) {
+            throw std::system_error(errno, std::generic_category(), "rename " + target);
+        }
+        committed_ = true;
+    }
+};
+
+inline void sync_file(int fd, const std::string& path) {
+    while (::fsync(fd) != 0) {
+        if (errno == EINTR) continue;
+        throw std::system_error(errno, std::generic_category(), "fsync " + path);
+    }
+}
+
+// Makes a rename within the directory durable.
+inline void sync_parent_directory(const std::string& path) {
+    const std::size_t slash = path.rfind('/');
+    const std::string directory = slash == std::string::npos ? "." 
+                                : slash == 0 ? "/" : path.substr(0, slash);
+    
+    FileDescriptor dir(::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC));
+    if (dir.get() < 0) {
+        throw std::system_error(errno, std::generic_category(), "open " + directory);
+    }
+    sync_file(dir.get(), directory);
+    dir.close();
+}
+
+[[noreturn]] inline void invalid_snapshot(const char* what) {
+    throw std::system_error(std::make_error_code(std::errc::invalid_argument), what);
+}
+
+}
+
+// Writes path + ".tmp", syncs it and renames it over path, so a crash or a failed write
+// leaves the previous snapshot intact.
+template<typename T, std::size_t ChunkCapacity>
+void snapshot_queue(const PmrQueue<T, ChunkedStorage<ChunkCapacity>>& queue, 
+                    const std::string& path) {
+    static_assert(std::is_trivially_copyable_v<T>, 
+                  "snapshots require trivially copyable elements");
+    
+    snapshot_detail::TemporaryFile temporary(path + ".tmp");
+    snapshot_detail::FileDescriptor file(::open(temporary.path().c_str(), 
+                                                O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644));
+    if (file.get() < 0) {
+        throw std::system_error(errno, std::generic_category(), "open " + temporary.path());
+    }
+    
+    QueueSnapshotHeader header{QueueSnapshotHeader::expected_magic, 
+                               QueueSnapshotHeader::current_version,
+                               static_cast<std::uint32_t>(sizeof(T)), alignof(T), queue.size()};
+    
+    std::vector<iovec> buffers;
+    buffers.reserve(queue.size() / ChunkCapacity + 3);
+    buffers.push_back({&header, sizeof(header)});
+    queue.for_each_segment([&](std::span<const T> segment) {
+        buffers.push_back({const_cast<T*>(segment.data()), segment.size_bytes()});
+    });
+    
+    snapshot_detail::write_all(file.get(), buffers);
+    snapshot_detail::sync_file(file.get(), temporary.path());
+    file.close();
+    
+    temporary.commit_to(path);
+    snapshot_detail::sync_parent_directory(path);
+}
+
+// Appends the snapshot's elements to queue and returns how many were restored.
+template<typename T, std::size_t ChunkCapacity>
+std::size_t restore_queue(PmrQueue<T, ChunkedStorage<ChunkCapacity>>& queue, 
+                          const std::string& path) {
+    static_assert(std::is_trivially_copyable_v<T>, 
+                  "snapshots require trivially copyable elements");
+    
+    snapshot_detail::FileDescriptor file(::open(path.c_str(), O_RDONLY | O_CLOEXEC));
+    if (file.get() < 0) {
+        throw std::system_error(errno, std::generic_category(), "open " + path);
+    }
+    
+    struct stat info{};
+    if (::fstat(file.get(), &info) != 0) {
+        throw std::system_error(errno, std::generic_category(), "fstat " + path);
+    }
+    
+    const std::size_t file_size = static_cast<std::size_t>(info.st_size);
+    if (file_size < sizeof(QueueSnapshotHeader)) {
+        snapshot_detail::invalid_snapshot("truncated snapshot header");
+    }
+    
+    snapshot_detail::MappedFile mapping(file.get(), file_size);
+    QueueSnapshotHeader header;
+    std::memcpy(&header, mapping.data(), sizeof(header));
+    
+    if (header.magic != QueueSnapshotHeader::expected_magic ||
+        header.version != QueueSnapshotHeader::current_version) {
+        snapshot_detail::invalid_snapshot("not a queue snapshot");
+    }
+    if (header.element_size != sizeof(T) || header.element_alignment != alignof(T)) {
+        snapshot_detail::invalid_snapshot("snapshot element type mismatch");
+    }
+    if (header.count > (file_size - sizeof(header)) / sizeof(T) ||
+        file_size - sizeof(header) != header.count * sizeof(T)) {
+        snapshot_detail::invalid_snapshot("snapshot size does not match element count");
+    }
+    
+    // The mapping is page aligned, so payloads stay aligned for any alignof(T) up to 32.
+    if (reinterpret_cast<std::uintptr_t>(mapping.data() + sizeof(header)) % alignof(T) != 0) {
+        snapshot_detail::invalid_snapshot("snapshot payload is misaligned");
+    }
+    const T* elements = reinterpret_cast<const T*>(mapping.data() + sizeof(header));
+    queue.push_range(elements, elements + header.count);
+    return header.count;
+}
@@ -0,0 +1,127 @@
+#pragma once
+#include "pmr_queue.h"
+
+// Log-linear histogram in the style of HdrHistogram: every power of two is split into
+// 2^sub_bucket_bits linear buckets, so recorded values keep about 6% relative precision.
+class LatencyHistogram {
+public:
+    static constexpr unsigned sub_bucket_bits = 4;
+    static constexpr std::size_t sub_buckets = std::size_t{1} << sub_bucket_bits;
+    static constexpr std::size_t bucket_count = sub_buckets * (64 - sub_bucket_bits + 1);
+
+private:
+    std::array<std::uint64_t, bucket_count> counts_{};
+    std::uint64_t total_ = 0;
+    std::uint64_t sum_ = 0;
+    std::uint64_t min_ = std::numeric_limits<std::uint64_t>::max();
+    std::uint64_t max_ = 0;
+
+public:
+    static std::size_t bucket_of(std::uint64_t value) {
+        if (value < sub_buckets) {
+            return static_cast<std::size_t>(value);
+        }
+        const unsigned shift = static_cast<unsigned>(std::bit_width(value)) - 1 - sub_bucket_bits;
+        return sub_buckets * (shift + 1) + static_cast<std::size_t>((value >> shift) - sub_buckets);
+    }
+    
+    static std::uint64_t bucket_upper_bound(std::size_t bucket) {
+        if (bucket < sub_buckets) {
+            return bucket;
+        }
+        const unsigned shift = static_cast<unsigned>(bucket / sub_buckets - 1);
+        const std::uint64_t lower = static_cast<std::uint64_t>(sub_buckets + bucket % sub_buckets) << shift;
+        return lower + ((std::uint64_t{1} << shift) - 1);
+    }
+    
+    void record(std::uint64_t value) {
+        ++counts_[bucket_of(value)];
+        ++total_;
+        sum_ += value;
+        min_ = std::min(min_, value);
+        max_ = std::max(max_, value);
+    }
+    
+    std::uint64_t count() const { 
+        return total_; 
+    }
+    
+    std::uint64_t min() const { 
+        return total_ ? min_ : 0; 
+    }
+    
+    std::uint64_t max() const { 
+        return max_; 
+    }
+    
+    double mean() const {
+        return total_ ? static_cast<double>(sum_) / static_cast<double>(total_) : 0.0;
+    }
+    
+    // Returns the upper bound of the bucket holding the requested percentile, capped at max().
+    std::uint64_t percentile(double percent) const {
+        if (total_ == 0) return 0;
+        
+        const double clamped = std::clamp(percent, 0.0, 100.0);
+        const std::uint64_t rank = std::max<std::uint64_t>(
+            1, static_cast<std::uint64_t>(clamped / 100.0 * static_cast<double>(total_) + 0.5));
+        
+        std::uint64_t seen = 0;
+        for (std::size_t bucket = 0; bucket < bucket_count; ++bucket) {
+            seen += counts_[bucket];
+            if (seen >= rank) {
+                return std::min(bucket_upper_bound(bucket), max_);
+            }
+        }
+        return max_;
+    }
+    
+    void reset() {
+        *this = LatencyHistogram{};
+    }
+};
+
+class QueueLatencyRecorder : public QueueInstrumentation {
+private:
+    LatencyHistogram push_latency_;
+    LatencyHistogram pop_latency_;
+    LatencyHistogram residency_;
+    std::size_t depth_high_water_ = 0;
+
+public:
+    void on_push(std::uint64_t latency_ns, std::size_t depth) override {
+        push_latency_.record(latency_ns);
+        depth_high_water_ = std::max(depth_high_water_, depth);
+    }
+    
+    void on_pop(std::uint64_t latency_ns, std::size_t, 
+                std::optional<std::uint64_t> residency_ns) override {
+        pop_latency_.record(latency_ns);
+        if (residency_ns) {
+            residency_.record(*residency_ns);
+        }
+    }
+    
+    const LatencyHistogram& push_latency() const { 
+        return push_latency_; 
+    }
+    
+    const LatencyHistogram& pop_latency() const { 
+        return pop_latency_; 
+    }
+    
+    const LatencyHistogram& residency() const { 
+        return residency_; 
+    }
+    
+    std::size_t depth_high_water() const { 
+        return depth_high_water_; 
+    }
+    
+    void reset() {
+        push_latency_.reset();
+        pop_latency_.reset();
+        residency_.reset();
+        depth_high_water_ = 0;
+    }
+};
@@ -0,0 +1,322 @@
+#pragma once
+#include "pmr_queue.h"
+#include <atomic>
+#include <cerrno>
+#include <optional>
+#include <system_error>
+#include <thread>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+class SharedMemoryRegion {
+private:
+    int fd_;
+    std::byte* base_;
+    std::size_t size_;
+
+public:
+    explicit SharedMemoryRegion(std::size_t size, const char* name = "pmr_queue")
+        : fd_(::memfd_create(name, MFD_CLOEXEC)), base_(nullptr), size_(size) {
+        if (fd_ < 0) {
+            throw std::system_error(errno, std::generic_category(), "memfd_create");
+        }
+        if (::ftruncate(fd_, static_cast<off_t>(size_)) != 0) {
+            const int error = errno;
+            ::close(fd_);
+            throw std::system_error(error, std::generic_category(), "ftruncate");
+        }
+        map();
+    }
+    
+    // Maps an existing region again, e.g. from a descriptor received over a Unix socket.
+    SharedMemoryRegion(int fd, std::size_t size)
+        : fd_(::fcntl(fd, F_DUPFD_CLOEXEC, 0)), base_(nullptr), size_(size) {
+        if (fd_ < 0) {
+            throw std::system_error(errno, std::generic_category(), "fcntl");
+        }
+        map();
+    }
+    
+    ~SharedMemoryRegion() {
+        ::munmap(base_, size_);
+        ::close(fd_);
+    }
+    
+    SharedMemoryRegion(const SharedMemoryRegion&) = delete;
+    SharedMemoryRegion& operator=(const SharedMemoryRegion&) = delete;
+    
+    int fd() const { 
+        return fd_; 
+    }
+    
+    std::byte* data() const { 
+        return base_; 
+    }
+    
+    std::size_t size() const { 
+        return size_; 
+    }
+
+private:
+    void map() {
+        void* base = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        if (base == MAP_FAILED) {
+            const int error = errno;
+            ::close(fd_);
+            throw std::system_error(error, std::generic_category(), "mmap");
+        }
+        base_ = static_cast<std::byte*>(base);
+    }
+};
+
+enum class SharedMemoryMode {
+    create,
+    attach
+};
+
+// Everything stored in the region refers to other blocks by offset from the region base,
+// so each process may map it at a different address.
+class SharedMemoryResource : public std::pmr::memory_resource {
+public:
+    using offset_type = std::uint64_t;
+    
+    static constexpr std::size_t min_block_size = 16;
+    static constexpr std::size_t max_alignment = 4096;
+    static constexpr std::size_t size_classes = 48;
+
+private:
+    static_assert(std::atomic<offset_type>::is_always_lock_free, 
+                  "shared offsets must be address-free atomics");
+    
+    struct Header {
+        static constexpr std::uint64_t expected_magic = 0x504d52534841524dULL;
+        
+        std::uint64_t magic;
+        std::uint64_t size;
+        std::atomic<offset_type> root;
+        std::atomic_flag lock;
+        offset_type bump;
+        offset_type free_lists[size_classes];
+    };
+    
+    class SpinLock {
+    private:
+        std::atomic_flag& flag_;
+    
+    public:
+        explicit SpinLock(std::atomic_flag& flag) : flag_(flag) {
+            while (flag_.test_and_set(std::memory_order_acquire)) {
+                while (flag_.test(std::memory_order_relaxed)) {
+                    std::this_thread::yield();
+                }
+            }
+        }
+        
+        ~SpinLock() {
+            flag_.clear(std::memory_order_release);
+        }
+    };
+    
+    std::byte* base_;
+    Header* header_;
+
+public:
+    SharedMemoryResource(SharedMemoryRegion& region, SharedMemoryMode mode)
+        : base_(region.data()), header_(reinterpret_cast<Header*>(region.data())) {
+        if (mode == SharedMemoryMode::create) {
+            if (region.size() < sizeof(Header)) {
+                throw std::system_error(std::make_error_code(std::errc::invalid_argument),
+                                        "shared memory region too small");
+            }
+            Header* header = std::construct_at(header_);
+            header->size = region.size();
+            header->bump = sizeof(Header);
+            std::fill(std::begin(header->free_lists), std::end(header->free_lists), 0);
+            std::atomic_ref<std::uint64_t>(header->magic)
+                .store(Header::expected_magic, std::memory_order_release);
+        } else if (std::atomic_ref<std::uint64_t>(header_->magic).load(std::memory_order_acquire) 
+                   != Header::expected_magic) {
+            throw std::system_error(std::make_error_code(std::errc::invalid_argument),
+                                    "shared memory region is not initialized");
+        }
+    }
+    
+    SharedMemoryResource(const SharedMemoryResource&) = delete;
+    SharedMemoryResource& operator=(const SharedMemoryResource&) = delete;
+    
+    offset_type to_offset(const void* ptr) const {
+        return ptr ? static_cast<offset_type>(static_cast<const std::byte*>(ptr) - base_) : 0;
+    }
+    
+    template<typename T>
+    T* from_offset(offset_type offset) const {
+        return offset ? reinterpret_cast<T*>(base_ + offset) : nullptr;
+    }
+    
+    offset_type root() const {
+        return header_->root.load(std::memory_order_acquire);
+    }
+    
+    // Publishes the region's root object once; returns the root that ends up installed.
+    offset_type publish_root(offset_type root) {
+        offset_type expected = 0;
+        if (header_->root.compare_exchange_strong(expected, root, std::memory_order_acq_rel)) {
+            return root;
+        }
+        return expected;
+    }
+    
+    std::size_t bytes_used() const {
+        SpinLock lock(header_->lock);
+        return header_->bump;
+    }
+
+protected:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        if (alignment > max_alignment) {
+            throw std::bad_alloc();
+        }
+        
+        const std::size_t size_class = class_of(std::max({bytes, alignment, min_block_size}));
+        const std::size_t block_size = std::size_t{1} << size_class;
+        
+        SpinLock lock(header_->lock);
+        if (offset_type head = header_->free_lists[size_class]) {
+            header_->free_lists[size_class] = *from_offset<offset_type>(head);
+            return base_ + head;
+        }
+        
+        const std::size_t block_alignment = std::min(block_size, max_alignment);
+        const offset_type offset = (header_->bump + block_alignment - 1) & ~(block_alignment - 1);
+        if (offset > header_->size || block_size > header_->size - offset) {
+            throw std::bad_alloc();
+        }
+        header_->bump = offset + block_size;
+        return base_ + offset;
+    }
+    
+    void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override {
+        const std::size_t size_class = class_of(std::max({bytes, alignment, min_block_size}));
+        
+        SpinLock lock(header_->lock);
+        *static_cast<offset_type*>(ptr) = header_->free_lists[size_class];
+        header_->free_lists[size_class] = to_offset(ptr);
+    }
+    
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+private:
+    static std::size_t class_of(std::size_t bytes) {
+        const std::size_t size_class = std::bit_width(bytes - 1);
+        if (size_class >= size_classes) {
+            throw std::bad_alloc();
+        }
+        return size_class;
+    }
+};
+
+// A single-producer single-consumer linked queue whose links are region offsets.
+// Producer and consumer may live in different processes with separate mappings.
+template<typename T>
+class SharedSpscQueue {
+    static_assert(std::is_trivially_copyable_v<T>, 
+                  "shared queue elements must be trivially copyable");
+
+private:
+    using offset_type = SharedMemoryResource::offset_type;
+    
+    struct Node {
+        std::atomic<offset_type> next;
+        alignas(T) std::byte storage[sizeof(T)];
+    };
+    
+    struct State {
+        alignas(cache_line_size) offset_type head;
+        alignas(cache_line_size) offset_type tail;
+        alignas(cache_line_size) std::atomic<std::uint64_t> pushed;
+        alignas(cache_line_size) std::atomic<std::uint64_t> popped;
+    };
+    
+    using node_allocator = std::pmr::polymorphic_allocator<Node>;
+    using state_allocator = std::pmr::polymorphic_allocator<State>;
+    
+    SharedMemoryResource* resource_;
+    State* state_;
+
+public:
+    // Opens the queue rooted in the region, creating it on first use.
+    explicit SharedSpscQueue(SharedMemoryResource& mr) 
+        : resource_(&mr), state_(mr.from_offset<State>(mr.root())) {
+        if (state_) return;
+        
+        State* state = state_allocator(resource_).allocate(1);
+        Node* sentinel;
+        try {
+            sentinel = make_node();
+        } catch (...) {
+            state_allocator(resource_).deallocate(state, 1);
+            throw;
+        }
+        std::construct_at(state);
+        state->head = resource_->to_offset(sentinel);
+        state->tail = state->head;
+        
+        const offset_type root = resource_->publish_root(resource_->to_offset(state));
+        if (root != resource_->to_offset(state)) {
+            node_allocator(resource_).deallocate(sentinel, 1);
+            state_allocator(resource_).deallocate(state, 1);
+        }
+        state_ = resource_->from_offset<State>(root);
+    }
+    
+    void push(const T& value) {
+        Node* node = make_node();
+        std::construct_at(reinterpret_cast<T*>(node->storage), value);
+        
+        Node* tail = resource_->from_offset<Node>(state_->tail);
+        tail->next.store(resource_->to_offset(node), std::memory_order_release);
+        state_->tail = resource_->to_offset(node);
+        state_->pushed.fetch_add(1, std::memory_order_release);
+    }
+    
+    std::optional<T> try_pop() {
+        Node* head = resource_->from_offset<Node>(state_->head);
+        const offset_type next = head->next.load(std::memory_order_acquire);
+        if (!next) return std::nullopt;
+        
+        Node* node = resource_->from_offset<Node>(next);
+        std::optional<T> result(*std::launder(reinterpret_cast<T*>(node->storage)));
+        state_->head = next;
+        node_allocator(resource_).deallocate(head, 1);
+        state_->popped.fetch_add(1, std::memory_order_release);
+        return result;
+    }
+    
+    bool try_pop(T& out) {
+        std::optional<T> value = try_pop();
+        if (!value) return false;
+        
+        out = *value;
+        return true;
+    }
+    
+    bool empty() const {
+        return size() == 0;
+    }
+    
+    std::size_t size() const {
+        const std::uint64_t popped = state_->popped.load(std::memory_order_acquire);
+        const std::uint64_t pushed = state_->pushed.load(std::memory_order_acquire);
+        return static_cast<std::size_t>(pushed - popped);
+    }
+
+private:
+    Node* make_node() {
+        Node* node = node_allocator(resource_).allocate(1);
+        std::construct_at(&node->next, 0);
+        return node;
+    }
+};
@@ -0,0 +1,157 @@
+#pragma once
+#include "pmr_queue.h"
+#include "pmr_wait.h"
+#include <atomic>
+#include <bit>
+#include <optional>
+
+template<typename T>
+class SpscPmrQueue {
+private:
+    using allocator_type = std::pmr::polymorphic_allocator<T>;
+    
+    struct alignas(cache_line_size) ProducerState {
+        std::atomic<std::size_t> tail{0};
+        std::size_t cached_head = 0;
+    };
+    
+    struct alignas(cache_line_size) ConsumerState {
+        std::atomic<std::size_t> head{0};
+        std::size_t cached_tail = 0;
+    };
+    
+    ProducerState producer_;
+    ConsumerState consumer_;
+    std::size_t mask_;
+    allocator_type allocator_;
+    T* slots_;
+    EventCount not_empty_;
+    EventCount not_full_;
+
+public:
+    explicit SpscPmrQueue(std::size_t capacity,
+                         std::pmr::memory_resource* mr = 
+                         std::pmr::get_default_resource())
+        : mask_(std::bit_ceil(std::max<std::size_t>(capacity, 1)) - 1),
+          allocator_(mr), slots_(allocator_.allocate(mask_ + 1)) {}
+    
+    ~SpscPmrQueue() {
+        std::size_t head = consumer_.head.load(std::memory_order_relaxed);
+        const std::size_t tail = producer_.tail.load(std::memory_order_relaxed);
+        for (; head != tail; ++head) {
+            std::destroy_at(slots_ + (head & mask_));
+        }
+        allocator_.deallocate(slots_, mask_ + 1);
+    }
+    
+    SpscPmrQueue(const SpscPmrQueue&) = delete;
+    SpscPmrQueue& operator=(const SpscPmrQueue&) = delete;
+    
+    template<typename U>
+    bool try_push(U&& value) {
+        return try_emplace(std::forward<U>(value));
+    }
+    
+    template<typename... Args>
+    bool try_emplace(Args&&... args) {
+        const std::size_t tail = producer_.tail.load(std::memory_order_relaxed);
+        if (tail - producer_.cached_head > mask_) {
+            producer_.cached_head = consumer_.head.load(std::memory_order_acquire);
+            if (tail - producer_.cached_head > mask_) {
+                return false;
+            }
+        }
+        
+        std::uninitialized_construct_using_allocator(slots_ + (tail & mask_), allocator_, 
+                                                    std::forward<Args>(args)...);
+        producer_.tail.store(tail + 1, std::memory_order_release);
+        not_empty_.notify_one();
+        return true;
+    }
+    
+    template<typename U, typename Rep, typename Period>
+    bool push_wait(U&& value, const std::chrono::duration<Rep, Period>& timeout) {
+        return not_full_.await([&] { return try_push(std::forward<U>(value)); },
+                               wait_deadline(timeout));
+    }
+    
+    template<typename U>
+    void push_wait(U&& value) {
+        (void)not_full_.await([&] { return try_push(std::forward<U>(value)); },
+                              EventCount::clock::time_point::max());
+    }
+    
+    bool try_pop(T& out) {
+        T* slot = front();
+        if (!slot) return false;
+        
+        out = std::move(*slot);
+        pop();
+        return true;
+    }
+    
+    std::optional<T> try_pop() {
+        T* slot = front();
+        if (!slot) return std::nullopt;
+        
+        std::optional<T> result(std::move(*slot));
+        pop();
+        return result;
+    }
+    
+    T* front() {
+        const std::size_t head = consumer_.head.load(std::memory_order_relaxed);
+        if (head == consumer_.cached_tail) {
+            consumer_.cached_tail = producer_.tail.load(std::memory_order_acquire);
+            if (head == consumer_.cached_tail) {
+                return nullptr;
+            }
+        }
+        return slots_ + (head & mask_);
+    }
+    
+    void pop() {
+        T* slot = front();
+        if (!slot) return;
+        
+        const std::size_t head = consumer_.head.load(std::memory_order_relaxed);
+        std::destroy_at(slot);
+        consumer_.head.store(head + 1, std::memory_order_release);
+        not_full_.notify_one();
+    }
+    
+    template<typename Rep, typename Period>
+    bool pop_wait(T& out, const std::chrono::duration<Rep, Period>& timeout) {
+        return not_empty_.await([&] { return try_pop(out); }, wait_deadline(timeout));
+    }
+    
+    template<typename Rep, typename Period>
+    std::optional<T> pop_wait(const std::chrono::duration<Rep, Period>& timeout) {
+        std::optional<T> result;
+        (void)not_empty_.await([&] { return (result = try_pop()).has_value(); },
+                               wait_deadline(timeout));
+        return result;
+    }
+    
+    T pop_wait() {
+        std::optional<T> result;
+        (void)not_empty_.await([&] { return (result = try_pop()).has_value(); },
+                               EventCount::clock::time_point::max());
+        return std::move(*result);
+    }
+    
+    bool empty() const {
+        return consumer_.head.load(std::memory_order_acquire) == 
+               producer_.tail.load(std::memory_order_acquire);
+    }
+    
+    std::size_t size() const {
+        const std::size_t head = consumer_.head.load(std::memory_order_acquire);
+        const std::size_t tail = producer_.tail.load(std::memory_order_acquire);
+        return tail - head;
+    }
+    
+    std::size_t capacity() const {
+        return mask_ + 1;
+    }
+};
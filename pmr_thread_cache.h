@@ -0,0 +1,273 @@
+#pragma once
+#include "pmr_queue.h"
+#include <array>
+#include <atomic>
+#include <bit>
+#include <unordered_map>
+#include <vector>
+
+class ThreadCachingResource : public std::pmr::memory_resource {
+public:
+    static constexpr std::size_t min_block_size = 16;
+    static constexpr std::size_t size_classes = 8;
+    static constexpr std::size_t max_cached_size = min_block_size << (size_classes - 1);
+
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+    
+    struct FreeList {
+        FreeBlock* head = nullptr;
+        std::size_t count = 0;
+        
+        void push(FreeBlock* block) {
+            block->next = head;
+            head = block;
+            ++count;
+        }
+        
+        FreeBlock* pop() {
+            FreeBlock* block = head;
+            head = block->next;
+            --count;
+            return block;
+        }
+    };
+    
+    struct ThreadCache {
+        std::array<FreeList, size_classes> lists;
+        ThreadCache* next;
+    };
+    
+    struct CacheSlot {
+        std::uint64_t owner;
+        ThreadCache* cache;
+    };
+    
+    // On thread exit, hands each cache back to its resource if that resource is still alive.
+    struct ThreadSlots {
+        std::vector<CacheSlot> slots;
+        
+        ~ThreadSlots();
+    };
+    
+    std::pmr::memory_resource* upstream_;
+    std::size_t batch_size_;
+    std::uint64_t id_;
+    std::mutex mutex_;
+    std::array<FreeList, size_classes> central_;
+    ThreadCache* caches_;
+
+    static std::uint64_t next_id() {
+        static std::atomic<std::uint64_t> counter{1};
+        return counter.fetch_add(1, std::memory_order_relaxed);
+    }
+    
+    static std::vector<CacheSlot>& thread_slots() {
+        thread_local ThreadSlots slots;
+        return slots.slots;
+    }
+    
+    // Live resources by id, so threads never touch a cache whose resource is gone.
+    static std::mutex& registry_mutex() {
+        static std::mutex mutex;
+        return mutex;
+    }
+    
+    static std::unordered_map<std::uint64_t, ThreadCachingResource*>& registry() {
+        static std::unordered_map<std::uint64_t, ThreadCachingResource*> resources;
+        return resources;
+    }
+    
+    static std::size_t size_class(std::size_t bytes) {
+        return std::bit_width(std::max(bytes, min_block_size) - 1) - 
+               std::bit_width(min_block_size - 1);
+    }
+    
+    static std::size_t class_size(std::size_t index) {
+        return min_block_size << index;
+    }
+    
+    static bool cacheable(std::size_t bytes, std::size_t alignment) {
+        return bytes <= max_cached_size && alignment <= alignof(std::max_align_t);
+    }
+
+public:
+    explicit ThreadCachingResource(std::pmr::memory_resource* upstream = 
+                                  std::pmr::get_default_resource(),
+                                  std::size_t batch_size = 32)
+        : upstream_(upstream), batch_size_(std::max<std::size_t>(batch_size, 1)),
+          id_(next_id()), caches_(nullptr) {
+        std::lock_guard<std::mutex> lock(registry_mutex());
+        registry().emplace(id_, this);
+    }
+    
+    ThreadCachingResource(const ThreadCachingResource&) = delete;
+    ThreadCachingResource& operator=(const ThreadCachingResource&) = delete;
+    
+    ~ThreadCachingResource() override {
+        {
+            std::lock_guard<std::mutex> lock(registry_mutex());
+            registry().erase(id_);
+        }
+        
+        for (ThreadCache* cache = caches_; cache;) {
+            ThreadCache* next = cache->next;
+            for (std::size_t index = 0; index < size_classes; ++index) {
+                release_list(cache->lists[index], index);
+            }
+            upstream_->deallocate(cache, sizeof(ThreadCache), alignof(ThreadCache));
+            cache = next;
+        }
+        
+        for (std::size_t index = 0; index < size_classes; ++index) {
+            release_list(central_[index], index);
+        }
+    }
+    
+    std::size_t batch_size() const { 
+        return batch_size_; 
+    }
+    
+    std::size_t central_free_blocks() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::size_t total = 0;
+        for (const auto& list : central_) {
+            total += list.count;
+        }
+        return total;
+    }
+    
+    std::size_t thread_cache_count() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::size_t count = 0;
+        for (ThreadCache* cache = caches_; cache; cache = cache->next) {
+            ++count;
+        }
+        return count;
+    }
+    
+    // Caches held by the calling thread, across all resources it has used.
+    static std::size_t local_cache_slots() {
+        return thread_slots().size();
+    }
+
+protected:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        if (!cacheable(bytes, alignment)) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return upstream_->allocate(bytes, alignment);
+        }
+        
+        const std::size_t index = size_class(bytes);
+        FreeList& list = local_cache().lists[index];
+        if (!list.head) {
+            refill(list, index);
+        }
+        return list.pop();
+    }
+    
+    void do_deallocate(void* ptr, std::size_t bytes, 
+                      std::size_t alignment) override {
+        if (!cacheable(bytes, alignment)) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            upstream_->deallocate(ptr, bytes, alignment);
+            return;
+        }
+        
+        const std::size_t index = size_class(bytes);
+        FreeList& list = local_cache().lists[index];
+        list.push(static_cast<FreeBlock*>(ptr));
+        if (list.count > 2 * batch_size_) {
+            flush(list, index);
+        }
+    }
+    
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+private:
+    ThreadCache& local_cache() {
+        auto& slots = thread_slots();
+        for (const CacheSlot& slot : slots) {
+            if (slot.owner == id_) {
+                return *slot.cache;
+            }
+        }
+        
+        prune_slots(slots);
+        
+        ThreadCache* cache;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            cache = static_cast<ThreadCache*>(
+                upstream_->allocate(sizeof(ThreadCache), alignof(ThreadCache)));
+            std::construct_at(cache);
+            cache->next = caches_;
+            caches_ = cache;
+        }
+        slots.push_back({id_, cache});
+        return *cache;
+    }
+    
+    static void prune_slots(std::vector<CacheSlot>& slots) {
+        std::lock_guard<std::mutex> lock(registry_mutex());
+        std::erase_if(slots, [](const CacheSlot& slot) { 
+            return !registry().contains(slot.owner); 
+        });
+    }
+    
+    void retire(ThreadCache* cache) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (std::size_t index = 0; index < size_classes; ++index) {
+            while (cache->lists[index].head) {
+                central_[index].push(cache->lists[index].pop());
+            }
+        }
+        
+        ThreadCache** link = &caches_;
+        while (*link != cache) {
+            link = &(*link)->next;
+        }
+        *link = cache->next;
+        upstream_->deallocate(cache, sizeof(ThreadCache), alignof(ThreadCache));
+    }
+    
+    void refill(FreeList& list, std::size_t index) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        FreeList& central = central_[index];
+        while (central.head && list.count < batch_size_) {
+            list.push(central.pop());
+        }
+        while (list.count < batch_size_) {
+            list.push(static_cast<FreeBlock*>(
+                upstream_->allocate(class_size(index), alignof(std::max_align_t))));
+        }
+    }
+    
+    void flush(FreeList& list, std::size_t index) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        FreeList& central = central_[index];
+        for (std::size_t i = 0; i < batch_size_; ++i) {
+            central.push(list.pop());
+        }
+    }
+    
+    void release_list(FreeList& list, std::size_t index) {
+        while (list.head) {
+            upstream_->deallocate(list.pop(), class_size(index), alignof(std::max_align_t));
+        }
+    }
+};
+
+inline ThreadCachingResource::ThreadSlots::~ThreadSlots() {
+    std::lock_guard<std::mutex> lock(registry_mutex());
+    for (const CacheSlot& slot : slots) {
+        auto it = registry().find(slot.owner);
+        if (it != registry().end()) {
+            it->second->retire(slot.cache);
+        }
+    }
+}
@@ -0,0 +1,157 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#if defined(__linux__)
+#include <climits>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#include <condition_variable>
+#include <mutex>
+#endif
+
+class EventCount {
+public:
+    using clock = std::chrono::steady_clock;
+
+private:
+    static constexpr std::uint32_t min_spins = 16;
+    static constexpr std::uint32_t max_spins = 4096;
+    
+    std::atomic<std::uint32_t> epoch_{0};
+    std::atomic<std::uint32_t> waiters_{0};
+    std::atomic<std::uint32_t> spin_limit_{256};
+#if !defined(__linux__)
+    std::mutex mutex_;
+    std::condition_variable condition_;
+#endif
+
+public:
+    EventCount() = default;
+    EventCount(const EventCount&) = delete;
+    EventCount& operator=(const EventCount&) = delete;
+    
+    // Producers pay a fence and a load; the wake-up syscall only happens with parked waiters.
+    void notify_one() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters_.load(std::memory_order_relaxed) != 0) {
+            epoch_.fetch_add(1, std::memory_order_release);
+            wake(1);
+        }
+    }
+    
+    void notify_all() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters_.load(std::memory_order_relaxed) != 0) {
+            epoch_.fetch_add(1, std::memory_order_release);
+            wake(INT32_MAX);
+        }
+    }
+    
+    template<typename TryOp>
+    bool await(TryOp&& try_op, clock::time_point deadline) {
+        const std::uint32_t spins = spin_limit_.load(std::memory_order_relaxed);
+        for (std::uint32_t i = 0; i < spins; ++i) {
+            if (try_op()) {
+                adapt(std::min(spins * 2, max_spins));
+                return true;
+            }
+            cpu_relax();
+        }
+        adapt(std::max(spins / 2, min_spins));
+        
+        while (true) {
+            waiters_.fetch_add(1, std::memory_order_seq_cst);
+            const std::uint32_t key = epoch_.load(std::memory_order_acquire);
+            if (try_op()) {
+                waiters_.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+            
+            const bool woken = park(key, deadline);
+            waiters_.fetch_sub(1, std::memory_order_relaxed);
+            if (try_op()) {
+                return true;
+            }
+            if (!woken) {
+                return false;
+            }
+        }
+    }
+
+private:
+    void adapt(std::uint32_t spins) {
+        spin_limit_.store(spins, std::memory_order_relaxed);
+    }
+    
+    static void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#else
+        std::this_thread::yield();
+#endif
+    }
+
+#if defined(__linux__)
+    std::uint32_t* futex_word() {
+        return reinterpret_cast<std::uint32_t*>(&epoch_);
+    }
+    
+    void wake(int count) {
+        syscall(SYS_futex, futex_word(), FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
+    }
+    
+    bool park(std::uint32_t key, clock::time_point deadline) {
+        if (deadline == clock::time_point::max()) {
+            syscall(SYS_futex, futex_word(), FUTEX_WAIT_PRIVATE, key, nullptr, nullptr, 0);
+            return true;
+        }
+        
+        const auto now = clock::now();
+        if (now >= deadline) {
+            return false;
+        }
+        const auto remaining = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - now);
+        timespec timeout{};
+        timeout.tv_sec = static_cast<time_t>(remaining.count() / 1000000000);
+        timeout.tv_nsec = static_cast<long>(remaining.count() % 1000000000);
+        syscall(SYS_futex, futex_word(), FUTEX_WAIT_PRIVATE, key, &timeout, nullptr, 0);
+        return clock::now() < deadline;
+    }
+#else
+    void wake(int count) {
+        std::lock_guard lock(mutex_);
+        if (count == 1) {
+            condition_.notify_one();
+        } else {
+            condition_.notify_all();
+        }
+    }
+    
+    bool park(std::uint32_t key, clock::time_point deadline) {
+        std::unique_lock lock(mutex_);
+        auto changed = [&] { return epoch_.load(std::memory_order_acquire) != key; };
+        if (deadline == clock::time_point::max()) {
+            condition_.wait(lock, changed);
+            return true;
+        }
+        return condition_.wait_until(lock, deadline, changed);
+    }
+#endif
+};
+
+template<typename Rep, typename Period>
+EventCount::clock::time_point wait_deadline(const std::chrono::duration<Rep, Period>& timeout) {
+    using seconds = std::chrono::duration<double>;
+    const auto now = EventCount::clock::now();
+    if (seconds(timeout) >= seconds(EventCount::clock::time_point::max() - now)) {
+        return EventCount::clock::time_point::max();
+    }
+    return now + std::chrono::duration_cast<EventCount::clock::duration>(timeout);
+}
@@ -0,0 +1,162 @@
+#pragma once
+#include "pmr_queue.h"
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <optional>
+
+template<typename T>
+class WorkStealingDeque {
+    static_assert(std::is_trivially_copyable_v<T>, 
+                  "work-stealing deque elements must be trivially copyable");
+
+private:
+    struct RingBuffer {
+        std::size_t mask;
+        std::atomic<T>* slots;
+        RingBuffer* previous;
+        
+        T load(std::int64_t index) const {
+            return slots[static_cast<std::size_t>(index) & mask].load(std::memory_order_relaxed);
+        }
+        
+        void store(std::int64_t index, const T& value) {
+            slots[static_cast<std::size_t>(index) & mask].store(value, std::memory_order_relaxed);
+        }
+    };
+    
+    using buffer_allocator = std::pmr::polymorphic_allocator<RingBuffer>;
+    using slot_allocator = std::pmr::polymorphic_allocator<std::atomic<T>>;
+    
+    alignas(cache_line_size) std::atomic<std::int64_t> top_;
+    alignas(cache_line_size) std::atomic<std::int64_t> bottom_;
+    alignas(cache_line_size) std::atomic<RingBuffer*> buffer_;
+    std::pmr::memory_resource* resource_;
+
+public:
+    explicit WorkStealingDeque(std::size_t capacity = 64,
+                              std::pmr::memory_resource* mr = 
+                              std::pmr::get_default_resource())
+        : top_(0), bottom_(0), resource_(mr) {
+        buffer_.store(make_buffer(std::bit_ceil(std::max<std::size_t>(capacity, 2)), nullptr),
+                      std::memory_order_relaxed);
+    }
+    
+    ~WorkStealingDeque() {
+        RingBuffer* buffer = buffer_.load(std::memory_order_relaxed);
+        while (buffer) {
+            RingBuffer* previous = buffer->previous;
+            destroy_buffer(buffer);
+            buffer = previous;
+        }
+    }
+    
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+    
+    void push(const T& value) {
+        const std::int64_t bottom = bottom_.load(std::memory_order_relaxed);
+        const std::int64_t top = top_.load(std::memory_order_acquire);
+        RingBuffer* buffer = buffer_.load(std::memory_order_relaxed);
+        
+        if (bottom - top > static_cast<std::int64_t>(buffer->mask)) {
+            buffer = grow(buffer, top, bottom);
+        }
+        
+        buffer->store(bottom, value);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(bottom + 1, std::memory_order_relaxed);
+    }
+    
+    std::optional<T> try_pop() {
+        const std::int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+        RingBuffer* buffer = buffer_.load(std::memory_order_relaxed);
+        bottom_.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t top = top_.load(std::memory_order_relaxed);
+        
+        if (top > bottom) {
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+            return std::nullopt;
+        }
+        
+        std::optional<T> result(buffer->load(bottom));
+        if (top == bottom) {
+            if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                              std::memory_order_relaxed)) {
+                result.reset();
+            }
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+        }
+        return result;
+    }
+    
+    std::optional<T> try_steal() {
+        std::int64_t top = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const std::int64_t bottom = bottom_.load(std::memory_order_acquire);
+        
+        if (top >= bottom) {
+            return std::nullopt;
+        }
+        
+        RingBuffer* buffer = buffer_.load(std::memory_order_acquire);
+        T value = buffer->load(top);
+        if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                          std::memory_order_relaxed)) {
+            return std::nullopt;
+        }
+        return value;
+    }
+    
+    bool empty() const {
+        return size() == 0;
+    }
+    
+    std::size_t size() const {
+        const std::int64_t bottom = bottom_.load(std::memory_order_acquire);
+        const std::int64_t top = top_.load(std::memory_order_acquire);
+        return bottom > top ? static_cast<std::size_t>(bottom - top) : 0;
+    }
+    
+    std::size_t capacity() const {
+        return buffer_.load(std::memory_order_acquire)->mask + 1;
+    }
+
+private:
+    RingBuffer* make_buffer(std::size_t capacity, RingBuffer* previous) {
+        buffer_allocator buffers(resource_);
+        slot_allocator slots(resource_);
+        
+        RingBuffer* buffer = buffers.allocate(1);
+        try {
+            std::atomic<T>* storage = slots.allocate(capacity);
+            for (std::size_t i = 0; i < capacity; ++i) {
+                std::construct_at(storage + i);
+            }
+            std::construct_at(buffer, RingBuffer{capacity - 1, storage, previous});
+        } catch (...) {
+            buffers.deallocate(buffer, 1);
+            throw;
+        }
+        return buffer;
+    }
+    
+    void destroy_buffer(RingBuffer* buffer) {
+        buffer_allocator buffers(resource_);
+        slot_allocator slots(resource_);
+        
+        slots.deallocate(buffer->slots, buffer->mask + 1);
+        buffers.deallocate(buffer, 1);
+    }
+    
+    // Thieves may still be reading the old ring, so it is kept until destruction.
+    RingBuffer* grow(RingBuffer* old_buffer, std::int64_t top, std::int64_t bottom) {
+        RingBuffer* buffer = make_buffer(2 * (old_buffer->mask + 1), old_buffer);
+        for (std::int64_t i = top; i < bottom; ++i) {
+            buffer->store(i, old_buffer->load(i));
+        }
+        buffer_.store(buffer, std::memory_order_release);
+        return buffer;
+    }
+};
@@ -0,0 +1,199 @@
+#include <gtest/gtest.h>
+#include <deque>
+#include <string>
+#include <thread>
+#include <vector>
+#include "pmr_async_queue.h"
+
+namespace {
+
+class ManualExecutor : public AsyncExecutor {
+    std::deque<std::coroutine_handle<>> ready_;
+
+public:
+    void schedule(std::coroutine_handle<> handle) override {
+        ready_.push_back(handle);
+    }
+    
+    std::size_t pending() const { 
+        return ready_.size(); 
+    }
+    
+    void run() {
+        while (!ready_.empty()) {
+            auto handle = ready_.front();
+            ready_.pop_front();
+            handle.resume();
+        }
+    }
+};
+
+// GCC false positive: it cannot pair PmrTask's template operator new with its operator delete.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+PmrTask consume(AsyncPmrQueue<std::string>& queue, std::size_t count, std::vector<std::string>& out) {
+    for (std::size_t i = 0; i < count; ++i) {
+        out.push_back(co_await queue.pop());
+    }
+}
+
+PmrTask produce(AsyncPmrQueue<int>& queue, int count, int& produced) {
+    for (int i = 0; i < count; ++i) {
+        co_await queue.push(i);
+        ++produced;
+    }
+}
+
+PmrTask sum_values(AsyncPmrQueue<int>& queue, int count, long long& sum) {
+    for (int i = 0; i < count; ++i) {
+        sum += co_await queue.pop();
+    }
+}
+
+PmrTask throwing(std::allocator_arg_t, const std::pmr::polymorphic_allocator<>&, AsyncPmrQueue<int>& queue) {
+    const int value = co_await queue.pop();
+    if (value < 0) {
+        throw std::runtime_error("negative");
+    }
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+}
+
+TEST(AsyncPmrQueueTest, PopSuspendsUntilPush) {
+    AsyncPmrQueue<std::string> queue;
+    std::vector<std::string> out;
+    
+    PmrTask task = consume(queue, 2, out);
+    EXPECT_FALSE(task.done());
+    EXPECT_TRUE(out.empty());
+    
+    EXPECT_TRUE(queue.try_push("first"));
+    EXPECT_EQ(out.size(), 1u);
+    EXPECT_FALSE(task.done());
+    
+    EXPECT_TRUE(queue.try_push("second"));
+    EXPECT_TRUE(task.done());
+    EXPECT_EQ(out, (std::vector<std::string>{"first", "second"}));
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(AsyncPmrQueueTest, PopCompletesImmediatelyWhenReady) {
+    AsyncPmrQueue<std::string> queue;
+    ASSERT_TRUE(queue.try_push("a"));
+    ASSERT_TRUE(queue.try_push("b"));
+    
+    std::vector<std::string> out;
+    PmrTask task = consume(queue, 2, out);
+    EXPECT_TRUE(task.done());
+    EXPECT_EQ(out, (std::vector<std::string>{"a", "b"}));
+}
+
+TEST(AsyncPmrQueueTest, PushAppliesBackpressure) {
+    AsyncPmrQueue<int> queue(2);
+    int produced = 0;
+    
+    PmrTask producer = produce(queue, 5, produced);
+    EXPECT_EQ(produced, 2);
+    EXPECT_EQ(queue.size(), 2u);
+    EXPECT_FALSE(queue.try_push(99));
+    
+    std::vector<int> popped;
+    while (auto value = queue.try_pop()) {
+        popped.push_back(*value);
+    }
+    EXPECT_TRUE(producer.done());
+    EXPECT_EQ(produced, 5);
+    EXPECT_EQ(popped, (std::vector<int>{0, 1, 2, 3, 4}));
+}
+
+TEST(AsyncPmrQueueTest, ProducerAndConsumerCoroutines) {
+    AsyncPmrQueue<int> queue(1);
+    long long sum = 0;
+    int produced = 0;
+    
+    PmrTask consumer = sum_values(queue, 100, sum);
+    PmrTask producer = produce(queue, 100, produced);
+    EXPECT_TRUE(producer.done());
+    EXPECT_TRUE(consumer.done());
+    EXPECT_EQ(sum, 4950);
+}
+
+TEST(AsyncPmrQueueTest, ExecutorDefersResumption) {
+    ManualExecutor executor;
+    AsyncPmrQueue<int> queue(1, std::pmr::get_default_resource(), &executor);
+    long long sum = 0;
+    
+    PmrTask consumer = sum_values(queue, 3, sum);
+    ASSERT_TRUE(queue.try_push(5));
+    EXPECT_EQ(executor.pending(), 1u);
+    EXPECT_EQ(sum, 0);
+    
+    executor.run();
+    EXPECT_EQ(sum, 5);
+    
+    ASSERT_TRUE(queue.try_push(6));
+    ASSERT_TRUE(queue.try_push(7));
+    EXPECT_EQ(executor.pending(), 1u);
+    EXPECT_FALSE(queue.try_push(8));
+    
+    executor.run();
+    EXPECT_EQ(sum, 18);
+    EXPECT_TRUE(consumer.done());
+}
+
+TEST(AsyncPmrQueueTest, FramesAndWaitersUseQueueResource) {
+    DynamicMemoryResource resource;
+    EXPECT_EQ(resource.bytes_in_use(), 0u);
+    {
+        AsyncPmrQueue<int> queue(4, &resource);
+        long long sum = 0;
+        {
+            PmrTask consumer = sum_values(queue, 1, sum);
+            EXPECT_GT(resource.bytes_in_use(), 0u);
+            ASSERT_TRUE(queue.try_push(3));
+            EXPECT_TRUE(consumer.done());
+        }
+        EXPECT_EQ(sum, 3);
+    }
+    EXPECT_EQ(resource.bytes_in_use(), 0u);
+}
+
+TEST(AsyncPmrQueueTest, AllocatorArgSelectsFrameResource) {
+    DynamicMemoryResource frames;
+    AsyncPmrQueue<int> queue;
+    {
+        PmrTask task = throwing(std::allocator_arg, &frames, queue);
+        EXPECT_GT(frames.bytes_in_use(), 0u);
+        
+        ASSERT_TRUE(queue.try_push(-1));
+        EXPECT_TRUE(task.done());
+        EXPECT_THROW(task.get(), std::runtime_error);
+    }
+    EXPECT_EQ(frames.bytes_in_use(), 0u);
+}
+
+TEST(AsyncPmrQueueTest, ResumesOnProducerThread) {
+    AsyncPmrQueue<int> queue(8);
+    long long sum = 0;
+    constexpr int count = 10000;
+    
+    PmrTask consumer = sum_values(queue, count, sum);
+    std::thread producer([&] {
+        for (int i = 0; i < count; ++i) {
+            while (!queue.try_push(i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+    producer.join();
+    
+    EXPECT_TRUE(consumer.done());
+    EXPECT_EQ(sum, static_cast<long long>(count) * (count - 1) / 2);
+}
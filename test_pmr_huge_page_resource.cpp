@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+#include "pmr_huge_page_resource.h"
+
+TEST(HugePageResourceTest, MapsWholeHugePages) {
+    HugePageResource mr;
+    EXPECT_EQ(mr.huge_page_size(), 2u * 1024 * 1024);
+    EXPECT_EQ(mr.mapped_bytes(), 0u);
+    
+    void* small = mr.allocate(64, 64);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(small) % 64, 0u);
+    EXPECT_EQ(mr.mapped_bytes(), mr.huge_page_size());
+    
+    void* large = mr.allocate(3 * 1024 * 1024);
+    EXPECT_EQ(mr.mapped_bytes() % mr.huge_page_size(), 0u);
+    
+    mr.deallocate(small, 64, 64);
+    mr.deallocate(large, 3 * 1024 * 1024);
+    EXPECT_EQ(mr.allocate(48), small);
+}
+
+TEST(HugePageResourceTest, ReusedBlocksHonourAlignment) {
+    HugePageResource mr;
+    
+    void* loose = mr.allocate(8192, 8);
+    mr.deallocate(loose, 8192, 8);
+    
+    for (std::size_t alignment : {std::size_t{8}, std::size_t{4096}, std::size_t{8192}, 
+                                  std::size_t{16384}, std::size_t{65536}}) {
+        void* block = mr.allocate(8192, alignment);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(block) % alignment, 0u) << alignment;
+        mr.deallocate(block, 8192, alignment);
+        
+        void* again = mr.allocate(8192, alignment);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(again) % alignment, 0u) << alignment;
+        mr.deallocate(again, 8192, alignment);
+    }
+}
+
+TEST(HugePageResourceTest, FallsBackToNormalPages) {
+    EXPECT_EQ(HugePageResource::huge_page_bytes(HugePageSize::size_1gb), std::size_t{1} << 30);
+    
+    HugePageResource mr({.allow_transparent = false});
+    
+    void* block = mr.allocate(4096);
+    ASSERT_NE(block, nullptr);
+    EXPECT_NE(mr.backing(), PageBacking::transparent_huge_pages);
+    mr.deallocate(block, 4096);
+}
+
+TEST(HugePageResourceTest, UpstreamForQueueResources) {
+    HugePageResource huge;
+    
+    DynamicMemoryResource dynamic(&huge);
+    PmrQueue<ComplexType> complex_queue(&dynamic);
+    for (int i = 0; i < 1000; ++i) {
+        complex_queue.push(ComplexType(i, i * 0.5, "huge"));
+    }
+    
+    QueueNodePoolResource<int> pool(4096, &huge);
+    PmrQueue<int> queue(&pool);
+    for (int i = 0; i < 100000; ++i) {
+        queue.push(i);
+    }
+    
+    EXPECT_EQ(complex_queue.back().id, 999);
+    EXPECT_EQ(queue.size(), 100000u);
+    EXPECT_EQ(huge.mapped_bytes() % huge.huge_page_size(), 0u);
+}
@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include "pmr_mpmc_queue.h"
+
+TEST(MpmcPmrQueueTest, FifoSingleThread) {
+    MpmcPmrQueue<int> queue;
+    EXPECT_TRUE(queue.empty());
+    EXPECT_FALSE(queue.try_pop().has_value());
+    
+    queue.push(1);
+    queue.push(2);
+    queue.push(3);
+    EXPECT_FALSE(queue.empty());
+    EXPECT_EQ(queue.size(), 3u);
+    
+    int value = 0;
+    EXPECT_TRUE(queue.try_pop(value));
+    EXPECT_EQ(value, 1);
+    EXPECT_EQ(queue.try_pop(), 2);
+    EXPECT_EQ(queue.try_pop(), 3);
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(MpmcPmrQueueTest, DestroysRemainingElements) {
+    std::pmr::synchronized_pool_resource pool;
+    MpmcPmrQueue<ComplexType> queue(&pool);
+    
+    queue.push(ComplexType(1, 1.0, "kept until destruction"));
+    queue.push(ComplexType(2, 2.0, "also kept"));
+    
+    auto first = queue.try_pop();
+    ASSERT_TRUE(first.has_value());
+    EXPECT_EQ(first->name, "kept until destruction");
+}
+
+TEST(MpmcPmrQueueTest, EmplaceMoveOnly) {
+    MpmcPmrQueue<std::unique_ptr<int>> queue;
+    
+    queue.emplace(new int(9));
+    auto value = queue.try_pop();
+    ASSERT_TRUE(value.has_value());
+    EXPECT_EQ(**value, 9);
+}
+
+TEST(MpmcPmrQueueTest, ManyProducersManyConsumers) {
+    constexpr int producers = 4;
+    constexpr int consumers = 4;
+    constexpr int per_producer = 20000;
+    
+    std::pmr::synchronized_pool_resource pool;
+    MpmcPmrQueue<int> queue(&pool);
+    std::atomic<long long> sum{0};
+    std::atomic<int> consumed{0};
+    std::vector<std::thread> threads;
+    
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p] {
+            for (int i = 0; i < per_producer; ++i) {
+                queue.push(p * per_producer + i);
+            }
+        });
+    }
+    
+    for (int c = 0; c < consumers; ++c) {
+        threads.emplace_back([&] {
+            while (consumed.load() < producers * per_producer) {
+                if (auto value = queue.try_pop()) {
+                    sum.fetch_add(*value);
+                    consumed.fetch_add(1);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    
+    const long long total = static_cast<long long>(producers) * per_producer;
+    EXPECT_EQ(sum.load(), total * (total - 1) / 2);
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(MpmcPmrQueueTest, PopWaitTimesOutWhenEmpty) {
+    MpmcPmrQueue<int> queue;
+    EXPECT_FALSE(queue.pop_wait(std::chrono::milliseconds(10)).has_value());
+    
+    queue.push(5);
+    int value = 0;
+    EXPECT_TRUE(queue.pop_wait(value, std::chrono::milliseconds(10)));
+    EXPECT_EQ(value, 5);
+}
+
+TEST(MpmcPmrQueueTest, ParkedConsumersAreWoken) {
+    constexpr int consumers = 3;
+    constexpr int per_consumer = 1000;
+    
+    std::pmr::synchronized_pool_resource pool;
+    MpmcPmrQueue<int> queue(&pool);
+    std::atomic<long long> sum{0};
+    std::vector<std::thread> threads;
+    
+    for (int c = 0; c < consumers; ++c) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < per_consumer; ++i) {
+                sum.fetch_add(queue.pop_wait());
+            }
+        });
+    }
+    
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    for (int i = 0; i < consumers * per_consumer; ++i) {
+        queue.push(i);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    
+    const long long total = static_cast<long long>(consumers) * per_consumer;
+    EXPECT_EQ(sum.load(), total * (total - 1) / 2);
+    EXPECT_TRUE(queue.empty());
+}
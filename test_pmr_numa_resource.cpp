@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <thread>
+#include "pmr_numa_resource.h"
+
+TEST(NumaLocalResourceTest, TopologyIsConsistent) {
+    const int nodes = numa_node_count();
+    EXPECT_GE(nodes, 1);
+    EXPECT_GE(current_numa_node(), 0);
+    EXPECT_LT(current_numa_node(), nodes);
+    EXPECT_LT(numa_node_of_cpu(0), nodes);
+    
+    EXPECT_THROW(NumaLocalResource{nodes}, std::invalid_argument);
+    EXPECT_THROW(NumaLocalResource{-1}, std::invalid_argument);
+}
+
+TEST(NumaLocalResourceTest, AllocatesAlignedBlocksAndRecyclesThem) {
+    NumaLocalResource mr(0, 64 * 1024);
+    EXPECT_EQ(mr.node(), 0);
+    
+    void* small = mr.allocate(24);
+    void* aligned = mr.allocate(100, 64);
+    void* large = mr.allocate(256 * 1024);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(aligned) % 64, 0u);
+    std::memset(large, 0xab, 256 * 1024);
+    
+    mr.deallocate(small, 24);
+    EXPECT_EQ(mr.allocate(32), small);
+    mr.deallocate(aligned, 100, 64);
+    mr.deallocate(large, 256 * 1024);
+    EXPECT_EQ(mr.allocate(200 * 1024), large);
+}
+
+TEST(NumaLocalResourceTest, UpstreamForDynamicMemoryResource) {
+    NumaArenaSet arenas(64 * 1024);
+    NumaLocalResource* local = arenas.local_resource();
+    EXPECT_EQ(local, arenas.resource_for_node(current_numa_node()));
+    EXPECT_EQ(local->node(), current_numa_node());
+    
+    DynamicMemoryResource mr({.synchronized = true}, local);
+    PmrQueue<ComplexType> queue(&mr);
+    
+    std::thread producer([&] {
+        for (int i = 0; i < 1000; ++i) {
+            queue.push(ComplexType(i, i * 0.5, "numa"));
+        }
+    });
+    producer.join();
+    
+    EXPECT_EQ(queue.size(), 1000u);
+    EXPECT_EQ(queue.front().id, 0);
+    EXPECT_EQ(queue.back().id, 999);
+}
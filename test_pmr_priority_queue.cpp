@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "pmr_priority_queue.h"
+
+struct Deadline {
+    int task;
+    long long due;
+};
+
+struct EarliestDeadline {
+    bool operator()(const Deadline& a, const Deadline& b) const {
+        return a.due > b.due;
+    }
+};
+
+TEST(PmrPriorityQueueTest, PopsInPriorityOrder) {
+    PmrPriorityQueue<int> queue;
+    EXPECT_TRUE(queue.empty());
+    EXPECT_FALSE(queue.try_top().has_value());
+    EXPECT_FALSE(queue.try_pop());
+    
+    for (int value : {5, 1, 9, 3, 7, 9, 0}) {
+        queue.push(value);
+    }
+    EXPECT_EQ(queue.size(), 7u);
+    EXPECT_EQ(queue.top(), 9);
+    
+    std::vector<int> popped;
+    int value = 0;
+    while (queue.try_pop(value)) {
+        popped.push_back(value);
+    }
+    EXPECT_EQ(popped, (std::vector<int>{9, 9, 7, 5, 3, 1, 0}));
+}
+
+TEST(PmrPriorityQueueTest, OrdersByDeadline) {
+    DynamicMemoryResource mr;
+    PmrPriorityQueue<Deadline, EarliestDeadline> queue(&mr);
+    EXPECT_EQ(queue.get_resource(), &mr);
+    
+    queue.push(Deadline{1, 300});
+    queue.emplace(Deadline{2, 100});
+    queue.push(Deadline{3, 200});
+    EXPECT_GT(mr.bytes_in_use(), 0u);
+    
+    EXPECT_EQ(queue.pop_value().task, 2);
+    EXPECT_EQ(queue.pop_value().task, 3);
+    EXPECT_EQ(queue.pop_value().task, 1);
+}
+
+TEST(PmrPriorityQueueTest, PushRangeMatchesSortedOrder) {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> dist(0, 1000);
+    std::vector<int> values(5000);
+    std::generate(values.begin(), values.end(), [&] { return dist(rng); });
+    
+    PmrPriorityQueue<int, std::less<int>, 8> queue;
+    queue.push(500);
+    queue.push_range(values.begin(), values.end());
+    queue.push_range(values.begin(), values.begin() + 10);
+    
+    std::vector<int> expected = values;
+    expected.push_back(500);
+    expected.insert(expected.end(), values.begin(), values.begin() + 10);
+    std::sort(expected.begin(), expected.end(), std::greater<int>());
+    
+    std::vector<int> popped;
+    while (!queue.empty()) {
+        popped.push_back(queue.pop_value());
+    }
+    EXPECT_EQ(popped, expected);
+}
+
+TEST(PmrPriorityQueueTest, PropagatesResourceToPmrElements) {
+    DynamicMemoryResource mr;
+    PmrPriorityQueue<std::pmr::string> queue(&mr);
+    
+    queue.push("a string long enough to defeat the small string buffer");
+    queue.emplace("zz another string long enough to need a heap allocation");
+    
+    EXPECT_EQ(queue.top().get_allocator().resource(), &mr);
+    queue.pop();
+    EXPECT_EQ(queue.top().get_allocator().resource(), &mr);
+}
@@ -1,6 +1,33 @@
 #include <gtest/gtest.h>
+#include <iterator>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
 #include "pmr_queue.h"
 
+class CountingResource : public std::pmr::memory_resource {
+public:
+    std::size_t allocations = 0;
+    std::size_t deallocations = 0;
+
+protected:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        ++allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    
+    void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override {
+        ++deallocations;
+        std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+    }
+    
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
 TEST(DynamicMemoryResourceTest, BasicAllocationDeallocation) {
     DynamicMemoryResource mr;
     
@@ -24,6 +51,371 @@ TEST(DynamicMemoryResourceTest, CleanupOnDestruction) {
     }
 }
 
+TEST(DynamicMemoryResourceTest, OutOfOrderDeallocation) {
+    DynamicMemoryResource mr;
+    std::vector<void*> blocks;
+    
+    for (int i = 0; i < 1000; ++i) {
+        blocks.push_back(mr.allocate(16 + i % 64));
+    }
+    
+    for (int i = 0; i < 1000; i += 2) {
+        mr.deallocate(blocks[i], 16 + i % 64);
+    }
+    
+    for (int i = 999; i > 0; i -= 2) {
+        mr.deallocate(blocks[i], 16 + i % 64);
+    }
+}
+
+TEST(DynamicMemoryResourceTest, InlineHeaderTracking) {
+    DynamicMemoryResource mr({.tracking = BlockTracking::inline_header});
+    EXPECT_EQ(mr.tracking(), BlockTracking::inline_header);
+    
+    void* ptr1 = mr.allocate(24);
+    void* ptr2 = mr.allocate(100, 64);
+    void* ptr3 = mr.allocate(8);
+    
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ptr2) % 64, 0u);
+    
+    mr.deallocate(ptr2, 100, 64);
+    mr.deallocate(ptr1, 24);
+    (void)mr.allocate(300);
+    (void)ptr3;
+}
+
+TEST(DynamicMemoryResourceTest, InlineHeaderHalvesUpstreamAllocations) {
+    constexpr int count = 1000;
+    
+    CountingResource indexed_upstream;
+    CountingResource inline_upstream;
+    {
+        DynamicMemoryResource indexed(&indexed_upstream);
+        DynamicMemoryResource inline_mr({.tracking = BlockTracking::inline_header},
+                                        &inline_upstream);
+        PmrQueue<int> indexed_queue(&indexed);
+        PmrQueue<int> inline_queue(&inline_mr);
+        
+        for (int i = 0; i < count; ++i) {
+            indexed_queue.push(i);
+            inline_queue.push(i);
+        }
+        
+        EXPECT_EQ(inline_upstream.allocations, static_cast<std::size_t>(count));
+        EXPECT_GE(indexed_upstream.allocations, 2u * count);
+    }
+    
+    EXPECT_EQ(inline_upstream.deallocations, inline_upstream.allocations);
+    EXPECT_EQ(indexed_upstream.deallocations, indexed_upstream.allocations);
+}
+
+TEST(DynamicMemoryResourceTest, SynchronizedModeAcrossThreads) {
+    for (BlockTracking tracking : {BlockTracking::indexed, BlockTracking::inline_header}) {
+        DynamicMemoryResource mr({.tracking = tracking, .synchronized = true});
+        EXPECT_TRUE(mr.synchronized());
+        
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&mr] {
+                PmrQueue<int> queue(&mr);
+                for (int i = 0; i < 2000; ++i) {
+                    queue.push(i);
+                    if (i % 3 == 0) {
+                        queue.pop();
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+}
+
+TEST(DynamicMemoryResourceTest, AllocationStats) {
+    if (!DynamicMemoryResource::stats_enabled) {
+        GTEST_SKIP() << "statistics compiled out";
+    }
+    
+    for (BlockTracking tracking : {BlockTracking::indexed, BlockTracking::inline_header}) {
+        DynamicMemoryResource mr({.tracking = tracking});
+        
+        void* small = mr.allocate(24);
+        void* aligned = mr.allocate(100, 64);
+        void* big = mr.allocate(4096);
+        
+        AllocationStats stats = mr.stats();
+        EXPECT_EQ(stats.allocations, 3u);
+        EXPECT_EQ(stats.live_bytes, 24u + 100u + 4096u);
+        EXPECT_EQ(stats.size_histogram[AllocationStats::bucket(24)], 1u);
+        EXPECT_EQ(stats.size_histogram[AllocationStats::bucket(4096)], 1u);
+        EXPECT_EQ(stats.alignment_histogram[AllocationStats::bucket(64)], 1u);
+        
+        mr.deallocate(big, 4096);
+        mr.deallocate(small, 24);
+        
+        stats = mr.stats();
+        EXPECT_EQ(stats.deallocations, 2u);
+        EXPECT_EQ(stats.live_bytes, 100u);
+        EXPECT_EQ(stats.peak_bytes, 24u + 100u + 4096u);
+        
+        mr.reset_stats();
+        EXPECT_EQ(mr.stats().allocations, 0u);
+        EXPECT_EQ(mr.stats().live_bytes, 100u);
+        mr.deallocate(aligned, 100, 64);
+        EXPECT_EQ(mr.stats().live_bytes, 0u);
+    }
+}
+
+TEST(DynamicMemoryResourceTest, CountsUnmatchedDeallocations) {
+    if (!DynamicMemoryResource::stats_enabled) {
+        GTEST_SKIP() << "statistics compiled out";
+    }
+    
+    DynamicMemoryResource mr;
+    DynamicMemoryResource other;
+    
+    void* foreign = other.allocate(32);
+    mr.deallocate(foreign, 32);
+    
+    EXPECT_EQ(mr.stats().unmatched_deallocations, 1u);
+    EXPECT_EQ(mr.stats().deallocations, 0u);
+    other.deallocate(foreign, 32);
+}
+
+TEST(DynamicMemoryResourceTest, InlineHeaderCountsOnlyOwnedPointers) {
+    if (!DynamicMemoryResource::stats_enabled) {
+        GTEST_SKIP() << "statistics compiled out";
+    }
+    
+    DynamicMemoryResource mr({.tracking = BlockTracking::inline_header});
+    std::vector<void*> blocks;
+    for (std::size_t size : {16, 48, 200, 1000}) {
+        blocks.push_back(mr.allocate(size));
+    }
+    mr.deallocate(blocks[2], 200);
+    mr.deallocate(blocks[0], 16);
+    mr.deallocate(blocks[3], 1000);
+    mr.deallocate(blocks[1], 48);
+    
+    EXPECT_EQ(mr.stats().deallocations, 4u);
+    EXPECT_EQ(mr.stats().unmatched_deallocations, 0u);
+    EXPECT_EQ(mr.stats().live_bytes, 0u);
+    EXPECT_EQ(mr.bytes_in_use(), 0u);
+}
+
+TEST(DynamicMemoryResourceTest, ByteBudget) {
+    for (BlockTracking tracking : {BlockTracking::indexed, BlockTracking::inline_header}) {
+        DynamicMemoryResource mr({.tracking = tracking, .byte_budget = 256});
+        
+        void* first = mr.allocate(128);
+        EXPECT_THROW((void)mr.allocate(256), std::bad_alloc);
+        EXPECT_GE(mr.bytes_in_use(), 128u);
+        
+        mr.deallocate(first, 128);
+        EXPECT_EQ(mr.bytes_in_use(), 0u);
+        
+        void* second = mr.allocate(200);
+        mr.deallocate(second, 200);
+    }
+}
+
+TEST(NodePoolResourceTest, ReusesFreedNodesLifo) {
+    NodePoolResource pool(32, alignof(std::max_align_t), 4);
+    
+    void* ptr1 = pool.allocate(32);
+    void* ptr2 = pool.allocate(32);
+    
+    pool.deallocate(ptr1, 32);
+    pool.deallocate(ptr2, 32);
+    
+    EXPECT_EQ(pool.allocate(32), ptr2);
+    EXPECT_EQ(pool.allocate(32), ptr1);
+}
+
+TEST(NodePoolResourceTest, SlabSizeIsConfigurable) {
+    CountingResource upstream;
+    {
+        NodePoolResource pool(16, alignof(std::max_align_t), 8, &upstream);
+        EXPECT_EQ(pool.nodes_per_slab(), 8u);
+        
+        for (int i = 0; i < 20; ++i) {
+            (void)pool.allocate(16);
+        }
+        
+        EXPECT_EQ(pool.slab_count(), 3u);
+        EXPECT_EQ(upstream.allocations, 3u);
+    }
+    EXPECT_EQ(upstream.deallocations, 3u);
+}
+
+TEST(NodePoolResourceTest, OversizedRequestsGoUpstream) {
+    CountingResource upstream;
+    NodePoolResource pool(16, alignof(std::max_align_t), 8, &upstream);
+    
+    void* big = pool.allocate(1024);
+    EXPECT_EQ(upstream.allocations, 1u);
+    EXPECT_EQ(pool.slab_count(), 0u);
+    
+    pool.deallocate(big, 1024);
+    EXPECT_EQ(upstream.deallocations, 1u);
+}
+
+TEST(NodePoolResourceTest, BacksPmrQueue) {
+    QueueNodePoolResource<ComplexType> pool(64);
+    PmrQueue<ComplexType> queue(&pool);
+    
+    for (int i = 0; i < 200; ++i) {
+        queue.push(ComplexType(i, i * 0.5, "node"));
+    }
+    EXPECT_EQ(pool.slab_count(), 4u);
+    
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(queue.front().id, i);
+        queue.pop();
+    }
+    
+    for (int i = 0; i < 100; ++i) {
+        queue.push(ComplexType(i, 0.0, "reused"));
+    }
+    EXPECT_EQ(pool.slab_count(), 4u);
+    EXPECT_EQ(queue.size(), 200u);
+}
+
+TEST(ArenaResourceTest, ResetReusesChunks) {
+    CountingResource upstream;
+    ArenaResource arena(1024, &upstream);
+    
+    for (int i = 0; i < 100; ++i) {
+        (void)arena.allocate(64);
+    }
+    const std::size_t chunks = upstream.allocations;
+    const std::size_t reserved = arena.reserved_bytes();
+    EXPECT_GE(reserved, 6400u);
+    
+    arena.reset();
+    for (int i = 0; i < 100; ++i) {
+        (void)arena.allocate(64);
+    }
+    EXPECT_EQ(upstream.allocations, chunks);
+    EXPECT_EQ(arena.reserved_bytes(), reserved);
+    
+    arena.release();
+    EXPECT_EQ(upstream.deallocations, chunks);
+    EXPECT_EQ(arena.reserved_bytes(), 0u);
+}
+
+TEST(ArenaResourceTest, HonoursAlignmentAndLargeRequests) {
+    ArenaResource arena(256);
+    
+    (void)arena.allocate(3, 1);
+    void* aligned = arena.allocate(64, 64);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(aligned) % 64, 0u);
+    
+    void* large = arena.allocate(10000);
+    EXPECT_NE(large, nullptr);
+}
+
+TEST(PmrQueueTest, ReleaseAllWithArena) {
+    CountingResource upstream;
+    ArenaResource arena(4096, &upstream);
+    
+    for (int request = 0; request < 3; ++request) {
+        PmrQueue<int> queue(&arena);
+        ChunkedPmrQueue<double, 16> chunked(&arena);
+        for (int i = 0; i < 200; ++i) {
+            queue.push(i);
+            chunked.push(i * 0.5);
+        }
+        EXPECT_EQ(queue.size(), 200);
+        
+        queue.release_all();
+        chunked.release_all();
+        EXPECT_TRUE(queue.empty());
+        EXPECT_TRUE(chunked.empty());
+        EXPECT_EQ(queue.begin(), queue.end());
+        
+        arena.reset();
+    }
+    EXPECT_LE(upstream.allocations, 2u);
+}
+
+class AlignmentCheckingResource : public std::pmr::memory_resource {
+public:
+    std::unordered_map<void*, std::pair<std::size_t, std::size_t>> live;
+    std::size_t mismatches = 0;
+
+protected:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        void* ptr = std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        live[ptr] = {bytes, alignment};
+        return ptr;
+    }
+    
+    void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override {
+        auto it = live.find(ptr);
+        if (it == live.end() || it->second != std::make_pair(bytes, alignment)) {
+            ++mismatches;
+        }
+        live.erase(ptr);
+        std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+    }
+    
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+struct alignas(64) SimdPayload {
+    float lanes[16];
+    
+    explicit SimdPayload(float value) {
+        std::fill(std::begin(lanes), std::end(lanes), value);
+    }
+};
+
+TEST(DynamicMemoryResourceTest, HonoursAlignmentOnEveryPath) {
+    for (BlockTracking tracking : {BlockTracking::indexed, BlockTracking::inline_header}) {
+        AlignmentCheckingResource upstream;
+        {
+            DynamicMemoryResource mr({.tracking = tracking}, &upstream);
+            PmrQueue<SimdPayload> queue(&mr);
+            
+            for (int i = 0; i < 8; ++i) {
+                SimdPayload& payload = queue.emplace(static_cast<float>(i));
+                EXPECT_EQ(reinterpret_cast<std::uintptr_t>(&payload) % 64, 0u);
+            }
+            queue.pop();
+            queue.release_all();
+        }
+        EXPECT_EQ(upstream.mismatches, 0u);
+        EXPECT_TRUE(upstream.live.empty());
+    }
+}
+
+TEST(PmrQueueTest, CacheAlignedNodes) {
+    DynamicMemoryResource mr({.tracking = BlockTracking::inline_header});
+    CacheAlignedPmrQueue<int> queue(&mr);
+    
+    for (int i = 0; i < 16; ++i) {
+        int& value = queue.emplace(i);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(&value) % cache_line_size, 0u);
+    }
+    
+    int expected = 0;
+    for (int value : queue) {
+        EXPECT_EQ(value, expected++);
+    }
+    EXPECT_EQ(queue.front(), 0);
+    
+    QueueNodePoolResource<int, cache_line_size> pool(8);
+    CacheAlignedPmrQueue<int> pooled(&pool);
+    for (int i = 0; i < 16; ++i) {
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(&pooled.emplace(i)) % cache_line_size, 0u);
+    }
+    EXPECT_EQ(pool.slab_count(), 2u);
+}
+
 TEST(PmrQueueTest, EmptyQueue) {
     PmrQueue<int> queue;
     EXPECT_TRUE(queue.empty());
@@ -153,6 +545,718 @@ TEST(PmrQueueTest, Clear) {
     EXPECT_EQ(queue.size(), 0);
 }
 
+TEST(PmrQueueTest, MoveAssignment) {
+    PmrQueue<int> queue1;
+    queue1.push(1);
+    queue1.push(2);
+    
+    PmrQueue<int> queue2;
+    queue2.push(3);
+    queue2 = std::move(queue1);
+    
+    EXPECT_TRUE(queue1.empty());
+    EXPECT_EQ(queue2.size(), 2);
+    EXPECT_EQ(queue2.front(), 1);
+}
+
+TEST(PmrQueueTest, ConstIteration) {
+    PmrQueue<int> queue;
+    queue.push(1);
+    queue.push(2);
+    
+    const PmrQueue<int>& cref = queue;
+    int sum = 0;
+    for (auto it = cref.begin(); it != cref.end(); ++it) {
+        sum += *it;
+    }
+    EXPECT_EQ(sum, 3);
+    EXPECT_TRUE(std::forward_iterator<PmrQueue<int>::const_iterator>);
+}
+
+TEST(ChunkedPmrQueueTest, PushPopAcrossChunks) {
+    ChunkedPmrQueue<int, 4> queue;
+    
+    for (int i = 0; i < 10; ++i) {
+        queue.push(i);
+    }
+    EXPECT_EQ(queue.size(), 10);
+    
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(queue.front(), i);
+        queue.pop();
+    }
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.begin(), queue.end());
+}
+
+TEST(ChunkedPmrQueueTest, IteratorMatchesNodeStorage) {
+    ChunkedPmrQueue<int, 3> chunked;
+    PmrQueue<int> linked;
+    
+    for (int i = 0; i < 8; ++i) {
+        chunked.push(i);
+        linked.push(i);
+    }
+    chunked.pop();
+    linked.pop();
+    
+    EXPECT_TRUE(std::equal(chunked.begin(), chunked.end(), linked.begin(), linked.end()));
+    EXPECT_TRUE(std::forward_iterator<ChunkedPmrQueue<int>::iterator>);
+    
+    const auto& cref = chunked;
+    int sum = 0;
+    for (const auto& item : cref) {
+        sum += item;
+    }
+    EXPECT_EQ(sum, 28);
+}
+
+TEST(ChunkedPmrQueueTest, FewerAllocations) {
+    CountingResource upstream;
+    {
+        ChunkedPmrQueue<int, 64> queue(&upstream);
+        for (int i = 0; i < 1000; ++i) {
+            queue.push(i);
+        }
+        EXPECT_EQ(upstream.allocations, 16u);
+        
+        for (int round = 0; round < 1000; ++round) {
+            queue.push(round);
+            queue.pop();
+        }
+        EXPECT_LE(upstream.allocations, 32u);
+    }
+    EXPECT_EQ(upstream.deallocations, upstream.allocations);
+}
+
+TEST(ChunkedPmrQueueTest, ComplexTypeAndClear) {
+    DynamicMemoryResource mr;
+    ChunkedPmrQueue<ComplexType, 2> queue(&mr);
+    
+    queue.push(ComplexType(1, 1.0, "one"));
+    queue.push(ComplexType(2, 2.0, "two"));
+    queue.push(ComplexType(3, 3.0, "three"));
+    queue.pop();
+    
+    EXPECT_EQ(queue.front().name, "two");
+    queue.clear();
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.size(), 0);
+    
+    queue.push(ComplexType(4, 4.0, "four"));
+    EXPECT_EQ(queue.front().id, 4);
+}
+
+TEST(ChunkedPmrQueueTest, MoveSemantics) {
+    ChunkedPmrQueue<int, 4> queue1;
+    for (int i = 0; i < 6; ++i) {
+        queue1.push(i);
+    }
+    
+    ChunkedPmrQueue<int, 4> queue2 = std::move(queue1);
+    EXPECT_TRUE(queue1.empty());
+    EXPECT_EQ(queue2.size(), 6);
+    
+    ChunkedPmrQueue<int, 4> queue3;
+    queue3.push(42);
+    queue3 = std::move(queue2);
+    EXPECT_EQ(queue3.front(), 0);
+    EXPECT_EQ(queue3.size(), 6);
+}
+
+TEST(PmrQueueTest, PushRange) {
+    PmrQueue<int> queue;
+    std::vector<int> values = {1, 2, 3, 4, 5};
+    
+    queue.push(0);
+    queue.push_range(values.begin(), values.end());
+    
+    EXPECT_EQ(queue.size(), 6);
+    EXPECT_TRUE(std::equal(std::next(queue.begin()), queue.end(), values.begin(), values.end()));
+    
+    queue.push_range(values.begin(), values.begin());
+    EXPECT_EQ(queue.size(), 6);
+}
+
+TEST(PmrQueueTest, PushRangeIsAllOrNothing) {
+    struct Fragile {
+        int value;
+        Fragile(int v) : value(v) {
+            if (v == 3) throw std::runtime_error("construction failed");
+        }
+    };
+    
+    DynamicMemoryResource mr({.tracking = BlockTracking::inline_header});
+    PmrQueue<Fragile> queue(&mr);
+    queue.push(0);
+    
+    std::vector<int> values = {1, 2, 3, 4};
+    EXPECT_THROW(queue.push_range(values.begin(), values.end()), std::runtime_error);
+    EXPECT_EQ(queue.size(), 1);
+    EXPECT_EQ(queue.front().value, 0);
+}
+
+TEST(PmrQueueTest, PopN) {
+    PmrQueue<int> queue;
+    for (int i = 0; i < 10; ++i) {
+        queue.push(i);
+    }
+    
+    std::vector<int> batch;
+    queue.pop_n(4, std::back_inserter(batch));
+    EXPECT_EQ(batch, (std::vector<int>{0, 1, 2, 3}));
+    EXPECT_EQ(queue.size(), 6);
+    EXPECT_EQ(queue.front(), 4);
+    
+    batch.clear();
+    queue.pop_n(100, std::back_inserter(batch));
+    EXPECT_EQ(batch.size(), 6u);
+    EXPECT_TRUE(queue.empty());
+    
+    queue.push(42);
+    EXPECT_EQ(queue.front(), 42);
+}
+
+TEST(PmrQueueTest, Drain) {
+    PmrQueue<ComplexType> queue;
+    queue.push(ComplexType(1, 1.0, "a"));
+    queue.push(ComplexType(2, 2.0, "b"));
+    queue.push(ComplexType(3, 3.0, "c"));
+    
+    std::string names;
+    std::size_t drained = queue.drain([&names](ComplexType&& item) {
+        names += item.name;
+    });
+    
+    EXPECT_EQ(drained, 3u);
+    EXPECT_EQ(names, "abc");
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.size(), 0);
+    
+    queue.push(ComplexType(4, 4.0, "d"));
+    EXPECT_EQ(queue.size(), 1);
+}
+
+TEST(ChunkedPmrQueueTest, BulkOperations) {
+    ChunkedPmrQueue<int, 4> queue;
+    std::vector<int> values(11);
+    std::iota(values.begin(), values.end(), 0);
+    
+    queue.push(-1);
+    queue.push_range(values.begin(), values.end());
+    EXPECT_EQ(queue.size(), 12);
+    
+    std::vector<int> batch;
+    queue.pop_n(6, std::back_inserter(batch));
+    EXPECT_EQ(batch, (std::vector<int>{-1, 0, 1, 2, 3, 4}));
+    EXPECT_EQ(queue.front(), 5);
+    EXPECT_EQ(queue.size(), 6);
+    
+    int sum = 0;
+    EXPECT_EQ(queue.drain([&sum](int value) { sum += value; }), 6u);
+    EXPECT_EQ(sum, 5 + 6 + 7 + 8 + 9 + 10);
+    EXPECT_TRUE(queue.empty());
+    
+    queue.push_range(values.begin(), values.begin() + 3);
+    EXPECT_EQ(queue.size(), 3);
+    EXPECT_EQ(queue.front(), 0);
+}
+
+TEST(PmrQueueTest, EmplaceConstructsInPlace) {
+    PmrQueue<ComplexType> queue;
+    
+    ComplexType& first = queue.emplace(1, 1.5, "emplaced");
+    EXPECT_EQ(&first, &queue.front());
+    EXPECT_EQ(queue.front().name, "emplaced");
+    
+    queue.emplace(2, 2.5, "second");
+    EXPECT_EQ(queue.size(), 2);
+}
+
+TEST(PmrQueueTest, MoveOnlyPayload) {
+    PmrQueue<std::unique_ptr<int>> queue;
+    
+    queue.push(std::make_unique<int>(1));
+    queue.emplace(new int(2));
+    
+    std::unique_ptr<int> first = queue.pop_value();
+    ASSERT_TRUE(first);
+    EXPECT_EQ(*first, 1);
+    EXPECT_EQ(queue.size(), 1);
+    
+    std::unique_ptr<int> second = queue.pop_value();
+    EXPECT_EQ(*second, 2);
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(ChunkedPmrQueueTest, EmplaceAndMoveOnlyPayload) {
+    ChunkedPmrQueue<std::unique_ptr<ComplexType>, 2> queue;
+    
+    for (int i = 0; i < 5; ++i) {
+        queue.emplace(std::make_unique<ComplexType>(i, 0.0, "boxed"));
+    }
+    
+    for (int i = 0; i < 5; ++i) {
+        std::unique_ptr<ComplexType> item = queue.pop_value();
+        EXPECT_EQ(item->id, i);
+    }
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(PmrQueueTest, PropagatesResourceToPmrElements) {
+    CountingResource upstream;
+    DynamicMemoryResource mr({.tracking = BlockTracking::inline_header}, &upstream);
+    PmrQueue<std::pmr::string> queue(&mr);
+    
+    const std::string long_text(100, 'x');
+    queue.push(long_text);
+    queue.emplace(50, 'y');
+    
+    EXPECT_EQ(queue.front().get_allocator().resource(), &mr);
+    EXPECT_EQ(upstream.allocations, 4u);
+    
+    std::pmr::string moved = queue.pop_value();
+    EXPECT_EQ(std::string_view(moved), long_text);
+    EXPECT_EQ(moved.get_allocator().resource(), &mr);
+}
+
+TEST(PmrQueueTest, PropagatesResourceToPmrComplexType) {
+    DynamicMemoryResource mr;
+    PmrQueue<PmrComplexType> queue(&mr);
+    ChunkedPmrQueue<PmrComplexType, 4> chunked(&mr);
+    
+    PmrComplexType outside(1, 1.0, "a name long enough to defeat small string storage");
+    queue.push(outside);
+    queue.emplace(2, 2.0, "another name long enough to defeat small string storage");
+    chunked.push(outside);
+    
+    EXPECT_EQ(outside.get_allocator().resource(), std::pmr::get_default_resource());
+    EXPECT_EQ(queue.front().get_allocator().resource(), &mr);
+    EXPECT_EQ(chunked.front().get_allocator().resource(), &mr);
+    EXPECT_EQ(queue.front(), outside);
+    
+    std::vector<PmrComplexType> items = {outside};
+    chunked.push_range(items.begin(), items.end());
+    chunked.pop();
+    EXPECT_EQ(chunked.front().get_allocator().resource(), &mr);
+}
+
+TEST(PmrQueueTest, BackAndOptionalAccess) {
+    PmrQueue<int> queue;
+    EXPECT_FALSE(queue.try_front().has_value());
+    EXPECT_FALSE(queue.try_back().has_value());
+    
+    queue.push(1);
+    EXPECT_EQ(queue.back(), 1);
+    queue.push(2);
+    queue.push(3);
+    EXPECT_EQ(queue.front(), 1);
+    EXPECT_EQ(queue.back(), 3);
+    
+    auto back = queue.try_back();
+    ASSERT_TRUE(back.has_value());
+    back->get() = 30;
+    EXPECT_EQ(queue.back(), 30);
+    
+    const PmrQueue<int>& cref = queue;
+    EXPECT_EQ(cref.try_front()->get(), 1);
+    EXPECT_EQ(cref.back(), 30);
+}
+
+TEST(PmrQueueTest, TryPop) {
+    PmrQueue<int> queue;
+    EXPECT_FALSE(queue.try_pop());
+    
+    queue.push(1);
+    queue.push(2);
+    
+    int value = 0;
+    EXPECT_TRUE(queue.try_pop(value));
+    EXPECT_EQ(value, 1);
+    EXPECT_TRUE(queue.try_pop());
+    EXPECT_FALSE(queue.try_pop(value));
+    EXPECT_EQ(value, 1);
+    EXPECT_TRUE(queue.empty());
+    EXPECT_FALSE(queue.try_back().has_value());
+}
+
+TEST(ChunkedPmrQueueTest, BackAndTryPop) {
+    ChunkedPmrQueue<int, 2> queue;
+    EXPECT_FALSE(queue.try_back().has_value());
+    
+    for (int i = 0; i < 5; ++i) {
+        queue.push(i);
+        EXPECT_EQ(queue.back(), i);
+        EXPECT_EQ(queue.try_back()->get(), i);
+    }
+    
+    int value = -1;
+    while (queue.try_pop(value)) {
+    }
+    EXPECT_EQ(value, 4);
+    EXPECT_TRUE(queue.empty());
+    EXPECT_FALSE(queue.try_front().has_value());
+    EXPECT_FALSE(queue.try_pop());
+}
+
+TEST(PmrQueueTest, SpliceBackSameResourceIsAllocationFree) {
+    CountingResource upstream;
+    DynamicMemoryResource mr({.tracking = BlockTracking::inline_header}, &upstream);
+    PmrQueue<int> left(&mr);
+    PmrQueue<int> right(&mr);
+    
+    for (int i = 0; i < 3; ++i) {
+        left.push(i);
+        right.push(10 + i);
+    }
+    const std::size_t allocations = upstream.allocations;
+    
+    left.splice_back(std::move(right));
+    EXPECT_EQ(upstream.allocations, allocations);
+    EXPECT_EQ(upstream.deallocations, 0u);
+    EXPECT_TRUE(right.empty());
+    EXPECT_EQ(right.size(), 0);
+    EXPECT_EQ(left.size(), 6);
+    EXPECT_EQ(left.back(), 12);
+    
+    std::vector<int> values(left.begin(), left.end());
+    EXPECT_EQ(values, (std::vector<int>{0, 1, 2, 10, 11, 12}));
+    
+    right.push(99);
+    EXPECT_EQ(right.front(), 99);
+}
+
+TEST(PmrQueueTest, SpliceBackDifferentResourceMovesElements) {
+    DynamicMemoryResource mr1;
+    DynamicMemoryResource mr2;
+    PmrQueue<ComplexType> left(&mr1);
+    PmrQueue<ComplexType> right(&mr2);
+    
+    left.emplace(1, 1.0, "left");
+    right.emplace(2, 2.0, "right");
+    right.emplace(3, 3.0, "right");
+    
+    left.splice_back(std::move(right));
+    EXPECT_TRUE(right.empty());
+    EXPECT_EQ(left.size(), 3);
+    EXPECT_EQ(left.back().id, 3);
+    EXPECT_EQ(left.get_resource(), &mr1);
+    
+    PmrQueue<ComplexType> empty(&mr1);
+    left.splice_back(std::move(empty));
+    EXPECT_EQ(left.size(), 3);
+}
+
+TEST(PmrQueueTest, SpliceBackDifferentResourceKeepsElementsOnThrow) {
+    DynamicMemoryResource budgeted({.byte_budget = 3 * sizeof(QueueNode<std::string>)});
+    DynamicMemoryResource source;
+    PmrQueue<std::string> left(&budgeted);
+    PmrQueue<std::string> right(&source);
+    
+    left.push(std::string(32, 'l'));
+    for (char c : {'a', 'b', 'c', 'd'}) {
+        right.push(std::string(32, c));
+    }
+    
+    EXPECT_THROW(left.splice_back(std::move(right)), std::bad_alloc);
+    EXPECT_EQ(left.size(), 3u);
+    EXPECT_EQ(left.back(), std::string(32, 'b'));
+    EXPECT_EQ(right.size(), 2u);
+    EXPECT_EQ(right.front(), std::string(32, 'c'));
+    EXPECT_EQ(right.back(), std::string(32, 'd'));
+}
+
+TEST(PmrQueueTest, SplitFront) {
+    DynamicMemoryResource mr;
+    PmrQueue<int> queue(&mr);
+    for (int i = 0; i < 10; ++i) {
+        queue.push(i);
+    }
+    
+    PmrQueue<int> head = queue.split_front(4);
+    EXPECT_EQ(head.size(), 4);
+    EXPECT_EQ(head.front(), 0);
+    EXPECT_EQ(head.back(), 3);
+    EXPECT_EQ(head.get_resource(), &mr);
+    EXPECT_EQ(queue.size(), 6);
+    EXPECT_EQ(queue.front(), 4);
+    
+    head.push(100);
+    EXPECT_EQ(head.back(), 100);
+    EXPECT_EQ(queue.front(), 4);
+    
+    PmrQueue<int> rest = queue.split_front(100);
+    EXPECT_EQ(rest.size(), 6);
+    EXPECT_TRUE(queue.empty());
+    EXPECT_FALSE(queue.try_back().has_value());
+    
+    EXPECT_TRUE(queue.split_front(3).empty());
+}
+
+TEST(PmrQueueTest, BoundedCapacity) {
+    PmrQueue<int> queue(PmrQueueOptions{.capacity = 3});
+    EXPECT_EQ(queue.capacity(), 3u);
+    
+    EXPECT_TRUE(queue.try_push(1));
+    EXPECT_TRUE(queue.try_emplace(2));
+    queue.push(3);
+    EXPECT_TRUE(queue.full());
+    
+    EXPECT_FALSE(queue.try_push(4));
+    EXPECT_THROW(queue.push(4), std::length_error);
+    EXPECT_EQ(queue.size(), 3u);
+    
+    queue.pop();
+    EXPECT_TRUE(queue.try_push(4));
+    EXPECT_EQ(queue.back(), 4);
+    
+    std::vector<int> values = {5, 6};
+    EXPECT_THROW(queue.push_range(values.begin(), values.end()), std::length_error);
+    EXPECT_EQ(queue.size(), 3u);
+    EXPECT_EQ(queue.split_front(1).capacity(), 3u);
+}
+
+TEST(ChunkedPmrQueueTest, BoundedCapacity) {
+    ChunkedPmrQueue<int, 4> queue(PmrQueueOptions{.capacity = 6});
+    
+    std::vector<int> values(10);
+    std::iota(values.begin(), values.end(), 0);
+    EXPECT_THROW(queue.push_range(values.begin(), values.end()), std::length_error);
+    EXPECT_TRUE(queue.empty());
+    
+    queue.push_range(values.begin(), values.begin() + 6);
+    EXPECT_EQ(queue.size(), 6u);
+    EXPECT_FALSE(queue.try_push(6));
+    
+    std::vector<int> popped;
+    queue.pop_n(6, std::back_inserter(popped));
+    EXPECT_EQ(popped, std::vector<int>(values.begin(), values.begin() + 6));
+    EXPECT_TRUE(queue.try_push(6));
+}
+
+TEST(ChunkedPmrQueueTest, PushRangeIsAllOrNothing) {
+    struct Fragile {
+        std::string value;
+        Fragile(int v) : value(std::to_string(v)) {
+            if (v == 7) throw std::runtime_error("construction failed");
+        }
+    };
+    
+    ChunkedPmrQueue<Fragile, 4> queue;
+    queue.push(0);
+    queue.push(1);
+    
+    std::vector<int> values = {2, 3, 4, 5, 6, 7, 8};
+    EXPECT_THROW(queue.push_range(values.begin(), values.end()), std::runtime_error);
+    EXPECT_EQ(queue.size(), 2u);
+    EXPECT_EQ(queue.back().value, "1");
+    EXPECT_EQ(std::distance(queue.begin(), queue.end()), 2);
+    
+    queue.push_range(values.begin(), values.begin() + 5);
+    EXPECT_EQ(queue.size(), 7u);
+    EXPECT_EQ(queue.back().value, "6");
+}
+
+TEST(ChunkedPmrQueueTest, InputRangeRollsBackAtCapacity) {
+    ChunkedPmrQueue<int, 2> queue(PmrQueueOptions{.capacity = 4});
+    queue.push(-1);
+    
+    std::istringstream input("1 2 3 4 5");
+    EXPECT_THROW(queue.push_range(std::istream_iterator<int>(input), std::istream_iterator<int>()),
+                 std::length_error);
+    EXPECT_EQ(queue.size(), 1u);
+    EXPECT_EQ(queue.back(), -1);
+    
+    EXPECT_TRUE(queue.try_push(1));
+    EXPECT_EQ(std::vector<int>(queue.begin(), queue.end()), (std::vector<int>{-1, 1}));
+}
+
+TEST(PmrQueueTest, TryPushFailsWhenBudgetIsExhausted) {
+    DynamicMemoryResource mr({.byte_budget = 4 * sizeof(QueueNode<int>)});
+    PmrQueue<int> queue(&mr);
+    
+    std::size_t pushed = 0;
+    while (queue.try_push(static_cast<int>(pushed))) {
+        ++pushed;
+    }
+    EXPECT_EQ(pushed, 4u);
+    EXPECT_THROW(queue.push(0), std::bad_alloc);
+    
+    queue.pop();
+    EXPECT_TRUE(queue.try_push(4));
+}
+
+TEST(ChunkedPmrQueueTest, SegmentsCoverLiveElements) {
+    ChunkedPmrQueue<int, 4> queue;
+    EXPECT_TRUE(queue.segments().empty());
+    
+    for (int i = 0; i < 10; ++i) {
+        queue.push(i);
+    }
+    queue.pop();
+    
+    std::vector<std::size_t> sizes;
+    std::vector<int> flattened;
+    for (std::span<int> segment : queue.segments()) {
+        sizes.push_back(segment.size());
+        flattened.insert(flattened.end(), segment.begin(), segment.end());
+    }
+    EXPECT_EQ(sizes, (std::vector<std::size_t>{3, 4, 2}));
+    EXPECT_EQ(flattened, std::vector<int>(queue.begin(), queue.end()));
+    
+    queue.for_each_segment([](std::span<int> segment) {
+        for (int& value : segment) {
+            value *= 2;
+        }
+    });
+    EXPECT_EQ(queue.front(), 2);
+    EXPECT_EQ(queue.back(), 18);
+}
+
+TEST(ChunkedPmrQueueTest, ReduceOverSegments) {
+    ChunkedPmrQueue<double, 16> queue;
+    EXPECT_EQ(queue.reduce(0.0), 0.0);
+    
+    for (int i = 1; i <= 1000; ++i) {
+        queue.push(static_cast<double>(i));
+    }
+    
+    const auto& view = queue;
+    EXPECT_EQ(view.reduce(0.0), 500500.0);
+    EXPECT_EQ(view.reduce(0.0, [](double a, double b) { return std::max(a, b); }), 1000.0);
+    EXPECT_EQ(view.transform_reduce(std::size_t{0}, std::plus<>(), 
+                                    [](double value) -> std::size_t { return value > 500.0; }), 
+              500u);
+}
+
+TEST(ChunkedPmrQueueTest, ParallelForEach) {
+    ChunkedPmrQueue<long long, 32> queue;
+    for (int i = 0; i < 10000; ++i) {
+        queue.push(i);
+    }
+    queue.pop();
+    
+    auto table = queue.segment_table();
+    std::size_t covered = 0;
+    for (std::span<long long> segment : table) {
+        covered += segment.size();
+    }
+    EXPECT_EQ(covered, queue.size());
+    
+    queue.for_each(std::execution::par, [](long long& value) { value *= 3; });
+    EXPECT_EQ(queue.reduce(0LL), 3LL * 10000 * 9999 / 2);
+    
+    std::atomic<long long> sum{0};
+    const auto& view = queue;
+    view.for_each(std::execution::par_unseq, [&](long long value) { 
+        sum.fetch_add(value, std::memory_order_relaxed); 
+    });
+    EXPECT_EQ(sum.load(), 3LL * 10000 * 9999 / 2);
+}
+
+TEST(ChunkedPmrQueueTest, ParallelClearDestroysEveryElement) {
+    static std::atomic<int> destroyed;
+    struct Tracked {
+        int id;
+        ~Tracked() { destroyed.fetch_add(1, std::memory_order_relaxed); }
+    };
+    
+    CountingResource upstream;
+    {
+        ChunkedPmrQueue<Tracked, 16> queue(&upstream);
+        for (int i = 0; i < 1000; ++i) {
+            queue.emplace(Tracked{i});
+        }
+        queue.pop();
+        destroyed = 0;
+        
+        queue.clear(std::execution::par);
+        EXPECT_EQ(destroyed.load(), 999);
+        EXPECT_TRUE(queue.empty());
+        EXPECT_EQ(queue.size(), 0u);
+        
+        queue.emplace(Tracked{1});
+        EXPECT_EQ(queue.front().id, 1);
+    }
+    EXPECT_EQ(upstream.allocations, upstream.deallocations);
+}
+
+TEST(ChunkedPmrQueueTest, ParallelClearStaysOffTheQueueResource) {
+    using Queue = ChunkedPmrQueue<std::string, 4>;
+    DynamicMemoryResource budgeted({.byte_budget = 4 * sizeof(QueueChunk<std::string, 4>)});
+    Queue queue(&budgeted);
+    for (int i = 0; i < 16; ++i) {
+        queue.push(std::to_string(i));
+    }
+    EXPECT_FALSE(queue.try_push("full"));
+    EXPECT_NO_THROW(queue.clear(std::execution::par));
+    EXPECT_TRUE(queue.empty());
+    
+    ArenaResource arena(4096);
+    Queue arena_queue(&arena);
+    for (int i = 0; i < 100; ++i) {
+        arena_queue.push(std::to_string(i));
+    }
+    const std::size_t reserved = arena.reserved_bytes();
+    for (int round = 0; round < 200; ++round) {
+        arena_queue.clear(std::execution::par);
+        arena_queue.push("again");
+    }
+    EXPECT_EQ(arena.reserved_bytes(), reserved);
+}
+
+TEST(PmrQueueTest, NodeCacheRecyclesNodes) {
+    CountingResource upstream;
+    PmrQueue<int> queue(PmrQueueOptions{.node_cache_limit = 8}, &upstream);
+    EXPECT_EQ(queue.node_cache_limit(), 8u);
+    
+    for (int round = 0; round < 10; ++round) {
+        for (int i = 0; i < 8; ++i) {
+            queue.push(i);
+        }
+        queue.clear();
+    }
+    EXPECT_EQ(upstream.allocations, 8u);
+    EXPECT_EQ(upstream.deallocations, 0u);
+    EXPECT_EQ(queue.cached_nodes(), 8u);
+    
+    for (int i = 0; i < 10; ++i) {
+        queue.push(i);
+    }
+    queue.clear();
+    EXPECT_EQ(upstream.allocations, 10u);
+    EXPECT_EQ(upstream.deallocations, 2u);
+    
+    queue.set_node_cache_limit(3);
+    EXPECT_EQ(queue.cached_nodes(), 3u);
+    queue.shrink_to_fit();
+    EXPECT_EQ(queue.cached_nodes(), 0u);
+    EXPECT_EQ(upstream.allocations, upstream.deallocations);
+}
+
+TEST(PmrQueueTest, ReservePrepopulatesNodeCache) {
+    CountingResource upstream;
+    {
+        PmrQueue<ComplexType> queue(&upstream);
+        queue.push(ComplexType(0, 0.0, "first"));
+        queue.reserve(16);
+        EXPECT_EQ(queue.cached_nodes(), 15u);
+        EXPECT_GE(queue.node_cache_limit(), 15u);
+        
+        const std::size_t allocations = upstream.allocations;
+        for (int i = 1; i < 16; ++i) {
+            queue.emplace(i, i * 0.5, "reserved");
+        }
+        EXPECT_EQ(upstream.allocations, allocations);
+        EXPECT_EQ(queue.cached_nodes(), 0u);
+        
+        PmrQueue<ComplexType> moved(std::move(queue));
+        moved.clear();
+        EXPECT_EQ(moved.cached_nodes(), moved.node_cache_limit());
+    }
+    EXPECT_EQ(upstream.allocations, upstream.deallocations);
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
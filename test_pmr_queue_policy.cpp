@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+#include "pmr_queue_policy.h"
+
+template<typename T>
+struct CountingAllocator {
+    using value_type = T;
+    
+    std::shared_ptr<std::size_t> allocations = std::make_shared<std::size_t>(0);
+    
+    CountingAllocator() = default;
+    
+    template<typename U>
+    CountingAllocator(const CountingAllocator<U>& other) : allocations(other.allocations) {}
+    
+    T* allocate(std::size_t n) {
+        ++*allocations;
+        return std::allocator<T>().allocate(n);
+    }
+    
+    void deallocate(T* ptr, std::size_t n) {
+        std::allocator<T>().deallocate(ptr, n);
+    }
+    
+    template<typename U>
+    bool operator==(const CountingAllocator<U>& other) const {
+        return allocations == other.allocations;
+    }
+};
+
+TEST(PolicyQueueTest, DefaultPolicyIsLeanNodeQueue) {
+    using Queue = ConfiguredQueue<int>;
+    static_assert(std::is_same_v<Queue, PolicyQueue<int, QueuePolicy<>>>);
+    
+    DynamicMemoryResource mr;
+    Queue queue(&mr);
+    for (int i = 0; i < 5; ++i) {
+        queue.push(i);
+    }
+    EXPECT_EQ(queue.get_allocator().resource(), &mr);
+    EXPECT_EQ(std::vector<int>(queue.begin(), queue.end()), (std::vector<int>{0, 1, 2, 3, 4}));
+    
+    int value = -1;
+    EXPECT_TRUE(queue.try_pop(value));
+    EXPECT_EQ(value, 0);
+    EXPECT_EQ(queue.front(), 1);
+}
+
+TEST(PolicyQueueTest, StatsCompileOut) {
+    using Lean = PolicyQueue<int, QueuePolicy<NodeStorage, SingleThreaded, 
+                                              StaticAllocation<std::allocator<int>>>>;
+    using Counted = PolicyQueue<int, QueuePolicy<NodeStorage, SingleThreaded, 
+                                                 StaticAllocation<std::allocator<int>>, true>>;
+    static_assert(sizeof(PolicyQueue<int, QueuePolicy<>>) == sizeof(PmrQueue<int>));
+    static_assert(sizeof(Counted) > sizeof(Lean));
+    
+    Counted queue;
+    for (int i = 0; i < 4; ++i) {
+        queue.push(i);
+    }
+    queue.pop();
+    queue.push(4);
+    queue.pop();
+    
+    EXPECT_EQ(queue.size(), 3u);
+    EXPECT_EQ(queue.stats().pushes, 5u);
+    EXPECT_EQ(queue.stats().pops, 2u);
+    EXPECT_EQ(queue.stats().high_water, 4u);
+}
+
+TEST(PolicyQueueTest, ChunkedStorageWithStaticAllocator) {
+    using Queue = ConfiguredQueue<std::string, QueuePolicy<ChunkedStorage<4>, SingleThreaded, 
+                                                           StaticAllocation<CountingAllocator<int>>, 
+                                                           true>>;
+    CountingAllocator<int> allocator;
+    {
+        Queue queue(allocator);
+        for (int i = 0; i < 10; ++i) {
+            queue.emplace(std::to_string(i));
+        }
+        EXPECT_EQ(*allocator.allocations, 3u);
+        
+        std::vector<std::string> values(queue.begin(), queue.end());
+        EXPECT_EQ(values.size(), 10u);
+        EXPECT_EQ(values.back(), "9");
+        
+        for (int i = 0; i < 5; ++i) {
+            queue.pop();
+        }
+        EXPECT_EQ(queue.front(), "5");
+        EXPECT_EQ(queue.size(), 5u);
+    }
+    EXPECT_EQ(*allocator.allocations, 3u);
+}
+
+TEST(PolicyQueueTest, KeepsPmrQueueCapacityAndNodeCache) {
+    DynamicMemoryResource mr;
+    PolicyQueue<int, QueuePolicy<NodeStorage, SingleThreaded, PmrAllocation, true>> queue(
+        PmrQueueOptions{2, 4}, &mr);
+    
+    EXPECT_FALSE(queue.try_front().has_value());
+    EXPECT_TRUE(queue.try_push(1));
+    EXPECT_TRUE(queue.try_push(2));
+    EXPECT_TRUE(queue.full());
+    EXPECT_FALSE(queue.try_push(3));
+    EXPECT_THROW(queue.push(3), std::length_error);
+    EXPECT_EQ(queue.stats().pushes, 2u);
+    EXPECT_EQ(queue.try_front()->get(), 1);
+    
+    queue.clear();
+    EXPECT_EQ(queue.stats().pops, 2u);
+    EXPECT_EQ(queue.stats().size, 0u);
+    
+    const std::size_t bytes = mr.bytes_in_use();
+    queue.push(5);
+    EXPECT_EQ(mr.bytes_in_use(), bytes);
+    queue.shrink_to_fit();
+    EXPECT_LT(mr.bytes_in_use(), bytes);
+}
+
+TEST(PolicyQueueTest, SelectsConcurrentQueues) {
+    static_assert(std::is_same_v<
+        ConfiguredQueue<int, QueuePolicy<NodeStorage, SingleProducerSingleConsumer>>,
+        SpscPmrQueue<int>>);
+    static_assert(std::is_same_v<
+        ConfiguredQueue<int, QueuePolicy<NodeStorage, MultiProducerMultiConsumer>>,
+        MpmcPmrQueue<int>>);
+    
+    ConfiguredQueue<int, QueuePolicy<NodeStorage, MultiProducerMultiConsumer>> queue;
+    queue.push(1);
+    EXPECT_EQ(queue.try_pop(), 1);
+}
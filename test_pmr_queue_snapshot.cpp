@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+#include "pmr_queue_snapshot.h"
+
+struct Sample {
+    std::uint64_t timestamp;
+    double value;
+    std::int32_t sensor;
+    
+    bool operator==(const Sample&) const = default;
+};
+
+class QueueSnapshotTest : public ::testing::Test {
+protected:
+    std::filesystem::path path_;
+    
+    void SetUp() override {
+        const auto* info = ::testing::UnitTest::GetInstance()->current_test_info();
+        path_ = std::filesystem::temp_directory_path() / 
+                (std::string("pmr_queue_snapshot_") + info->name() + ".bin");
+    }
+    
+    void TearDown() override {
+        std::filesystem::remove(path_);
+        std::filesystem::remove_all(path_.string() + ".tmp");
+    }
+};
+
+TEST_F(QueueSnapshotTest, RoundTripAcrossChunks) {
+    DynamicMemoryResource mr;
+    ChunkedPmrQueue<Sample, 8> queue(&mr);
+    for (int i = 0; i < 50; ++i) {
+        queue.push(Sample{static_cast<std::uint64_t>(i), i * 0.25, i % 4});
+    }
+    queue.pop();
+    queue.pop();
+    
+    snapshot_queue(queue, path_.string());
+    EXPECT_EQ(std::filesystem::file_size(path_), 
+              sizeof(QueueSnapshotHeader) + queue.size() * sizeof(Sample));
+    
+    ChunkedPmrQueue<Sample, 16> restored(&mr);
+    EXPECT_EQ(restore_queue(restored, path_.string()), 48u);
+    EXPECT_TRUE(std::equal(queue.begin(), queue.end(), restored.begin(), restored.end()));
+}
+
+TEST_F(QueueSnapshotTest, EmptyQueue) {
+    ChunkedPmrQueue<int> queue;
+    snapshot_queue(queue, path_.string());
+    
+    ChunkedPmrQueue<int> restored;
+    restored.push(7);
+    EXPECT_EQ(restore_queue(restored, path_.string()), 0u);
+    EXPECT_EQ(restored.size(), 1u);
+}
+
+TEST_F(QueueSnapshotTest, RejectsMismatchedSnapshots) {
+    ChunkedPmrQueue<int> queue;
+    queue.push(1);
+    snapshot_queue(queue, path_.string());
+    
+    ChunkedPmrQueue<double> wrong_type;
+    EXPECT_THROW(restore_queue(wrong_type, path_.string()), std::system_error);
+    EXPECT_TRUE(wrong_type.empty());
+    
+    std::filesystem::resize_file(path_, sizeof(QueueSnapshotHeader) + 2);
+    EXPECT_THROW(restore_queue(queue, path_.string()), std::system_error);
+    
+    {
+        std::ofstream garbage(path_, std::ios::binary | std::ios::trunc);
+        garbage << std::string(64, 'x');
+    }
+    EXPECT_THROW(restore_queue(queue, path_.string()), std::system_error);
+    
+    std::filesystem::remove(path_);
+    EXPECT_THROW(restore_queue(queue, path_.string()), std::system_error);
+    EXPECT_EQ(queue.size(), 1u);
+}
+
+TEST_F(QueueSnapshotTest, FailedSnapshotKeepsPreviousCheckpoint) {
+    ChunkedPmrQueue<int> queue;
+    for (int i = 0; i < 10; ++i) {
+        queue.push(i);
+    }
+    snapshot_queue(queue, path_.string());
+    EXPECT_FALSE(std::filesystem::exists(path_.string() + ".tmp"));
+    
+    queue.push(10);
+    std::filesystem::create_directory(path_.string() + ".tmp");
+    EXPECT_THROW(snapshot_queue(queue, path_.string()), std::system_error);
+    std::filesystem::remove(path_.string() + ".tmp");
+    
+    ChunkedPmrQueue<int> restored;
+    EXPECT_EQ(restore_queue(restored, path_.string()), 10u);
+    EXPECT_EQ(restored.back(), 9);
+}
+
+TEST_F(QueueSnapshotTest, FailedRenameRemovesTemporaryFile) {
+    std::filesystem::create_directory(path_);
+    
+    ChunkedPmrQueue<int> queue;
+    queue.push(1);
+    EXPECT_THROW(snapshot_queue(queue, path_.string()), std::system_error);
+    EXPECT_FALSE(std::filesystem::exists(path_.string() + ".tmp"));
+    EXPECT_TRUE(std::filesystem::is_directory(path_));
+}
@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include "pmr_queue_tracing.h"
+
+TEST(LatencyHistogramTest, BucketsKeepRelativePrecision) {
+    for (std::uint64_t value : {0ULL, 1ULL, 15ULL, 16ULL, 17ULL, 1000ULL, 123456789ULL, ~0ULL}) {
+        const std::size_t bucket = LatencyHistogram::bucket_of(value);
+        ASSERT_LT(bucket, LatencyHistogram::bucket_count);
+        const std::uint64_t upper = LatencyHistogram::bucket_upper_bound(bucket);
+        EXPECT_GE(upper, value);
+        EXPECT_LE(upper - value, value / LatencyHistogram::sub_buckets);
+    }
+}
+
+TEST(LatencyHistogramTest, Percentiles) {
+    LatencyHistogram histogram;
+    EXPECT_EQ(histogram.percentile(99.0), 0u);
+    
+    for (std::uint64_t value = 1; value <= 1000; ++value) {
+        histogram.record(value);
+    }
+    EXPECT_EQ(histogram.count(), 1000u);
+    EXPECT_EQ(histogram.min(), 1u);
+    EXPECT_EQ(histogram.max(), 1000u);
+    EXPECT_DOUBLE_EQ(histogram.mean(), 500.5);
+    EXPECT_NEAR(static_cast<double>(histogram.percentile(50.0)), 500.0, 500.0 / 16);
+    EXPECT_NEAR(static_cast<double>(histogram.percentile(99.0)), 990.0, 990.0 / 16);
+    EXPECT_EQ(histogram.percentile(100.0), 1000u);
+    
+    histogram.reset();
+    EXPECT_EQ(histogram.count(), 0u);
+}
+
+TEST(QueueTracingTest, RecordsOpLatencyAndDepth) {
+    if (!PmrQueue<int>::tracing_enabled) {
+        GTEST_SKIP() << "built without PMR_QUEUE_TRACING";
+    }
+    
+    QueueLatencyRecorder recorder;
+    PmrQueue<int> queue;
+    queue.set_instrumentation(&recorder);
+    EXPECT_EQ(queue.instrumentation(), &recorder);
+    
+    for (int i = 0; i < 10; ++i) {
+        queue.push(i);
+    }
+    for (int i = 0; i < 4; ++i) {
+        queue.pop();
+    }
+    
+    EXPECT_EQ(recorder.push_latency().count(), 10u);
+    EXPECT_EQ(recorder.pop_latency().count(), 4u);
+    EXPECT_EQ(recorder.residency().count(), 0u);
+    EXPECT_EQ(recorder.depth_high_water(), 10u);
+    
+    queue.set_instrumentation(nullptr);
+    queue.push(10);
+    EXPECT_EQ(recorder.push_latency().count(), 10u);
+}
+
+TEST(QueueTracingTest, TimestampedNodesReportResidency) {
+    static_assert(sizeof(TimestampedQueueNode<int>) > sizeof(QueueNode<int>));
+    if (!PmrQueue<int, TimestampedNodeStorage>::tracing_enabled) {
+        GTEST_SKIP() << "built without PMR_QUEUE_TRACING";
+    }
+    
+    QueueLatencyRecorder recorder;
+    PmrQueue<int, TimestampedNodeStorage> queue;
+    queue.set_instrumentation(&recorder);
+    
+    queue.push(1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    queue.push(2);
+    
+    int value = 0;
+    EXPECT_TRUE(queue.try_pop(value));
+    EXPECT_TRUE(queue.try_pop(value));
+    EXPECT_EQ(value, 2);
+    
+    ASSERT_EQ(recorder.residency().count(), 2u);
+    EXPECT_GE(recorder.residency().max(), 5'000'000u);
+    EXPECT_LT(recorder.residency().min(), recorder.residency().max());
+}
+
+TEST(QueueTracingTest, BatchPopsRecordEachElement) {
+    if (!PmrQueue<int, TimestampedNodeStorage>::tracing_enabled) {
+        GTEST_SKIP() << "built without PMR_QUEUE_TRACING";
+    }
+    
+    QueueLatencyRecorder recorder;
+    PmrQueue<int, TimestampedNodeStorage> queue;
+    queue.set_instrumentation(&recorder);
+    
+    const std::vector<int> values{1, 2, 3, 4, 5, 6};
+    queue.push_range(values.begin(), values.end());
+    EXPECT_EQ(recorder.push_latency().count(), 1u);
+    EXPECT_EQ(recorder.depth_high_water(), 6u);
+    
+    std::vector<int> out;
+    queue.pop_n(4, std::back_inserter(out));
+    EXPECT_EQ(recorder.pop_latency().count(), 4u);
+    EXPECT_EQ(queue.drain([](int) {}), 2u);
+    EXPECT_EQ(recorder.pop_latency().count(), 6u);
+    EXPECT_EQ(recorder.residency().count(), 6u);
+}
+
+TEST(QueueTracingTest, ChunkedQueueReportsOps) {
+    if (!ChunkedPmrQueue<int, 4>::tracing_enabled) {
+        GTEST_SKIP() << "built without PMR_QUEUE_TRACING";
+    }
+    
+    QueueLatencyRecorder recorder;
+    ChunkedPmrQueue<int, 4> queue;
+    queue.set_instrumentation(&recorder);
+    
+    for (int i = 0; i < 6; ++i) {
+        queue.push(i);
+    }
+    const std::vector<int> values{6, 7, 8};
+    queue.push_range(values.begin(), values.end());
+    EXPECT_EQ(recorder.push_latency().count(), 7u);
+    EXPECT_EQ(recorder.depth_high_water(), 9u);
+    
+    queue.pop();
+    std::vector<int> out;
+    queue.pop_n(5, std::back_inserter(out));
+    EXPECT_EQ(queue.drain([](int) {}), 3u);
+    EXPECT_EQ(recorder.pop_latency().count(), 9u);
+    EXPECT_EQ(recorder.residency().count(), 0u);
+}
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include "pmr_shared_memory.h"
+
+struct Message {
+    std::uint64_t sequence;
+    double payload;
+};
+
+TEST(SharedMemoryResourceTest, RecyclesBlocksBySizeClass) {
+    SharedMemoryRegion region(64 * 1024);
+    SharedMemoryResource mr(region, SharedMemoryMode::create);
+    
+    void* first = mr.allocate(24);
+    void* big = mr.allocate(1000, 64);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(big) % 64, 0u);
+    
+    mr.deallocate(first, 24);
+    EXPECT_EQ(mr.allocate(32), first);
+    
+    const std::size_t used = mr.bytes_used();
+    mr.deallocate(big, 1000, 64);
+    EXPECT_EQ(mr.allocate(1024), big);
+    EXPECT_EQ(mr.bytes_used(), used);
+    
+    EXPECT_THROW((void)mr.allocate(128 * 1024), std::bad_alloc);
+}
+
+TEST(SharedMemoryResourceTest, AttachRequiresInitializedRegion) {
+    SharedMemoryRegion region(4096);
+    EXPECT_THROW(SharedMemoryResource(region, SharedMemoryMode::attach), std::system_error);
+    
+    SharedMemoryResource creator(region, SharedMemoryMode::create);
+    SharedMemoryRegion second_mapping(region.fd(), region.size());
+    SharedMemoryResource attached(second_mapping, SharedMemoryMode::attach);
+    
+    void* block = creator.allocate(64);
+    EXPECT_EQ(attached.from_offset<std::byte>(creator.to_offset(block)), 
+              second_mapping.data() + (static_cast<std::byte*>(block) - region.data()));
+}
+
+TEST(SharedSpscQueueTest, VisibleThroughSecondMapping) {
+    SharedMemoryRegion region(1 << 20);
+    SharedMemoryRegion second_mapping(region.fd(), region.size());
+    ASSERT_NE(region.data(), second_mapping.data());
+    
+    SharedMemoryResource producer_mr(region, SharedMemoryMode::create);
+    SharedMemoryResource consumer_mr(second_mapping, SharedMemoryMode::attach);
+    SharedSpscQueue<Message> producer(producer_mr);
+    SharedSpscQueue<Message> consumer(consumer_mr);
+    
+    EXPECT_TRUE(consumer.empty());
+    EXPECT_FALSE(consumer.try_pop().has_value());
+    
+    for (std::uint64_t i = 0; i < 10; ++i) {
+        producer.push(Message{i, i * 0.5});
+    }
+    EXPECT_EQ(consumer.size(), 10u);
+    
+    for (std::uint64_t i = 0; i < 10; ++i) {
+        auto message = consumer.try_pop();
+        ASSERT_TRUE(message.has_value());
+        EXPECT_EQ(message->sequence, i);
+        EXPECT_EQ(message->payload, i * 0.5);
+    }
+    EXPECT_TRUE(producer.empty());
+}
+
+TEST(SharedSpscQueueTest, ProducerConsumerOnSeparateMappings) {
+    constexpr std::uint64_t count = 50000;
+    SharedMemoryRegion region(1 << 20);
+    SharedMemoryRegion second_mapping(region.fd(), region.size());
+    SharedMemoryResource producer_mr(region, SharedMemoryMode::create);
+    SharedMemoryResource consumer_mr(second_mapping, SharedMemoryMode::attach);
+    SharedSpscQueue<Message> queue(producer_mr);
+    
+    std::thread producer([&] {
+        for (std::uint64_t i = 0; i < count; ++i) {
+            while (queue.size() > 1000) {
+                std::this_thread::yield();
+            }
+            queue.push(Message{i, 1.0});
+        }
+    });
+    
+    SharedSpscQueue<Message> consumer(consumer_mr);
+    for (std::uint64_t i = 0; i < count; ++i) {
+        Message message{};
+        while (!consumer.try_pop(message)) {
+            std::this_thread::yield();
+        }
+        ASSERT_EQ(message.sequence, i);
+    }
+    producer.join();
+    EXPECT_TRUE(consumer.empty());
+}
@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include "pmr_spsc_queue.h"
+
+TEST(SpscPmrQueueTest, CapacityRoundsToPowerOfTwo) {
+    SpscPmrQueue<int> queue(5);
+    EXPECT_EQ(queue.capacity(), 8u);
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(SpscPmrQueueTest, TryPushFailsWhenFull) {
+    SpscPmrQueue<int> queue(4);
+    
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(queue.try_push(i));
+    }
+    EXPECT_FALSE(queue.try_push(4));
+    EXPECT_EQ(queue.size(), 4u);
+    
+    int value = -1;
+    EXPECT_TRUE(queue.try_pop(value));
+    EXPECT_EQ(value, 0);
+    EXPECT_TRUE(queue.try_push(4));
+}
+
+TEST(SpscPmrQueueTest, TryPopOnEmpty) {
+    SpscPmrQueue<int> queue(2);
+    int value = 7;
+    
+    EXPECT_FALSE(queue.try_pop(value));
+    EXPECT_EQ(value, 7);
+    EXPECT_FALSE(queue.try_pop().has_value());
+    EXPECT_EQ(queue.front(), nullptr);
+}
+
+TEST(SpscPmrQueueTest, PopOnEmptyIsNoop) {
+    SpscPmrQueue<std::string> queue(2);
+    queue.pop();
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.size(), 0u);
+    
+    EXPECT_TRUE(queue.try_push("a"));
+    EXPECT_TRUE(queue.try_push("b"));
+    EXPECT_FALSE(queue.try_push("c"));
+    queue.pop();
+    queue.pop();
+    queue.pop();
+    EXPECT_EQ(queue.size(), 0u);
+    EXPECT_EQ(queue.front(), nullptr);
+}
+
+TEST(SpscPmrQueueTest, WrapAroundWithComplexType) {
+    DynamicMemoryResource mr;
+    SpscPmrQueue<ComplexType> queue(2, &mr);
+    
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_TRUE(queue.try_push(ComplexType(i, i * 1.5, "item")));
+        auto item = queue.try_pop();
+        ASSERT_TRUE(item.has_value());
+        EXPECT_EQ(item->id, i);
+    }
+    
+    queue.try_push(ComplexType(99, 0.0, "left behind"));
+}
+
+TEST(SpscPmrQueueTest, ProducerConsumerThreads) {
+    constexpr int count = 100000;
+    SpscPmrQueue<int> queue(1024);
+    
+    std::thread producer([&] {
+        for (int i = 0; i < count; ++i) {
+            while (!queue.try_push(i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+    
+    long long sum = 0;
+    int expected = 0;
+    bool ordered = true;
+    while (expected < count) {
+        int value;
+        if (queue.try_pop(value)) {
+            ordered = ordered && value == expected;
+            sum += value;
+            ++expected;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    
+    EXPECT_TRUE(ordered);
+    EXPECT_EQ(sum, static_cast<long long>(count) * (count - 1) / 2);
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(SpscPmrQueueTest, EmplaceMoveOnly) {
+    SpscPmrQueue<std::unique_ptr<int>> queue(2);
+    
+    EXPECT_TRUE(queue.try_emplace(new int(5)));
+    auto value = queue.try_pop();
+    ASSERT_TRUE(value.has_value());
+    EXPECT_EQ(**value, 5);
+}
+
+TEST(SpscPmrQueueTest, PopWaitTimesOutWhenEmpty) {
+    SpscPmrQueue<int> queue(4);
+    int value = 7;
+    
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(queue.pop_wait(value, std::chrono::milliseconds(20)));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(20));
+    EXPECT_EQ(value, 7);
+    EXPECT_FALSE(queue.pop_wait(std::chrono::milliseconds(0)).has_value());
+}
+
+TEST(SpscPmrQueueTest, PushWaitAppliesBackpressure) {
+    SpscPmrQueue<int> queue(2);
+    EXPECT_TRUE(queue.try_push(0));
+    EXPECT_TRUE(queue.try_push(1));
+    EXPECT_FALSE(queue.push_wait(2, std::chrono::milliseconds(10)));
+    
+    std::thread consumer([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        EXPECT_EQ(queue.pop_wait(), 0);
+    });
+    EXPECT_TRUE(queue.push_wait(2, std::chrono::seconds(10)));
+    consumer.join();
+    
+    EXPECT_EQ(queue.pop_wait(), 1);
+    EXPECT_EQ(queue.pop_wait(), 2);
+}
+
+TEST(SpscPmrQueueTest, BlockingProducerConsumer) {
+    constexpr int count = 20000;
+    SpscPmrQueue<int> queue(16);
+    
+    std::thread producer([&] {
+        for (int i = 0; i < count; ++i) {
+            queue.push_wait(i);
+        }
+    });
+    
+    long long sum = 0;
+    for (int i = 0; i < count; ++i) {
+        int value = -1;
+        ASSERT_TRUE(queue.pop_wait(value, std::chrono::seconds(10)));
+        EXPECT_EQ(value, i);
+        sum += value;
+    }
+    producer.join();
+    
+    EXPECT_EQ(sum, static_cast<long long>(count) * (count - 1) / 2);
+    EXPECT_TRUE(queue.empty());
+}
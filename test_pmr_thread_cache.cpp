@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include "pmr_thread_cache.h"
+
+TEST(ThreadCachingResourceTest, ReusesBlocksWithinThread) {
+    ThreadCachingResource mr;
+    
+    void* ptr = mr.allocate(24);
+    mr.deallocate(ptr, 24);
+    EXPECT_EQ(mr.allocate(24), ptr);
+    mr.deallocate(ptr, 24);
+    
+    void* big = mr.allocate(4096);
+    EXPECT_NE(big, nullptr);
+    mr.deallocate(big, 4096);
+}
+
+TEST(ThreadCachingResourceTest, FlushesSurplusToCentralInBatches) {
+    ThreadCachingResource mr(std::pmr::get_default_resource(), 4);
+    std::vector<void*> blocks;
+    
+    for (int i = 0; i < 20; ++i) {
+        blocks.push_back(mr.allocate(64));
+    }
+    for (void* block : blocks) {
+        mr.deallocate(block, 64);
+    }
+    
+    EXPECT_GT(mr.central_free_blocks(), 0u);
+    EXPECT_EQ(mr.central_free_blocks() % mr.batch_size(), 0u);
+}
+
+TEST(ThreadCachingResourceTest, BacksDynamicMemoryResourceAcrossThreads) {
+    DynamicMemoryResource core({.synchronized = true});
+    ThreadCachingResource mr(&core);
+    
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&mr] {
+            PmrQueue<ComplexType> queue(&mr);
+            for (int i = 0; i < 5000; ++i) {
+                queue.push(ComplexType(i, 0.0, "cached"));
+                if (i % 2 == 0) {
+                    queue.pop();
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+TEST(ThreadCachingResourceTest, CrossThreadFrees) {
+    ThreadCachingResource mr;
+    std::vector<void*> blocks;
+    
+    for (int i = 0; i < 100; ++i) {
+        blocks.push_back(mr.allocate(32));
+    }
+    
+    std::thread releaser([&] {
+        for (void* block : blocks) {
+            mr.deallocate(block, 32);
+        }
+    });
+    releaser.join();
+    
+    void* reused = mr.allocate(32);
+    EXPECT_NE(reused, nullptr);
+    mr.deallocate(reused, 32);
+}
+
+TEST(ThreadCachingResourceTest, ThreadExitReturnsCacheToCentral) {
+    ThreadCachingResource mr(std::pmr::get_default_resource(), 8);
+    
+    std::thread worker([&mr] {
+        void* ptr = mr.allocate(32);
+        mr.deallocate(ptr, 32);
+    });
+    worker.join();
+    
+    EXPECT_EQ(mr.thread_cache_count(), 0u);
+    EXPECT_EQ(mr.central_free_blocks(), mr.batch_size());
+    
+    void* ptr = mr.allocate(32);
+    EXPECT_EQ(mr.central_free_blocks(), 0u);
+    mr.deallocate(ptr, 32);
+}
+
+TEST(ThreadCachingResourceTest, PrunesSlotsOfDestroyedResources) {
+    std::thread worker([] {
+        for (int i = 0; i < 100; ++i) {
+            ThreadCachingResource mr;
+            void* ptr = mr.allocate(16);
+            mr.deallocate(ptr, 16);
+        }
+        EXPECT_LE(ThreadCachingResource::local_cache_slots(), 1u);
+    });
+    worker.join();
+}
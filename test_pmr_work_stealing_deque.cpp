@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include "pmr_work_stealing_deque.h"
+
+TEST(WorkStealingDequeTest, OwnerPopsLifo) {
+    WorkStealingDeque<int> deque(4);
+    EXPECT_TRUE(deque.empty());
+    EXPECT_FALSE(deque.try_pop().has_value());
+    
+    deque.push(1);
+    deque.push(2);
+    deque.push(3);
+    EXPECT_EQ(deque.size(), 3u);
+    
+    EXPECT_EQ(deque.try_pop(), 3);
+    EXPECT_EQ(deque.try_pop(), 2);
+    EXPECT_EQ(deque.try_pop(), 1);
+    EXPECT_FALSE(deque.try_pop().has_value());
+    EXPECT_TRUE(deque.empty());
+}
+
+TEST(WorkStealingDequeTest, ThievesStealFifo) {
+    WorkStealingDeque<int> deque(4);
+    
+    for (int i = 0; i < 3; ++i) {
+        deque.push(i);
+    }
+    
+    EXPECT_EQ(deque.try_steal(), 0);
+    EXPECT_EQ(deque.try_pop(), 2);
+    EXPECT_EQ(deque.try_steal(), 1);
+    EXPECT_FALSE(deque.try_steal().has_value());
+}
+
+TEST(WorkStealingDequeTest, GrowsThroughMemoryResource) {
+    DynamicMemoryResource mr;
+    WorkStealingDeque<std::uint64_t> deque(2, &mr);
+    EXPECT_EQ(deque.capacity(), 2u);
+    
+    for (std::uint64_t i = 0; i < 100; ++i) {
+        deque.push(i);
+    }
+    EXPECT_EQ(deque.capacity(), 128u);
+    EXPECT_EQ(deque.size(), 100u);
+    
+    for (std::uint64_t i = 0; i < 100; ++i) {
+        EXPECT_EQ(deque.try_steal(), i);
+    }
+    EXPECT_TRUE(deque.empty());
+}
+
+TEST(WorkStealingDequeTest, ConcurrentStealingTakesEachTaskOnce) {
+    constexpr int tasks = 50000;
+    constexpr int thieves = 3;
+    
+    std::pmr::synchronized_pool_resource pool;
+    WorkStealingDeque<int> deque(16, &pool);
+    std::vector<std::atomic<int>> seen(tasks);
+    std::atomic<int> taken{0};
+    std::atomic<bool> done{false};
+    
+    std::vector<std::thread> threads;
+    for (int t = 0; t < thieves; ++t) {
+        threads.emplace_back([&] {
+            while (!done.load()) {
+                if (auto task = deque.try_steal()) {
+                    seen[*task].fetch_add(1);
+                    taken.fetch_add(1);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    
+    for (int i = 0; i < tasks; ++i) {
+        deque.push(i);
+        if (i % 3 == 0) {
+            if (auto task = deque.try_pop()) {
+                seen[*task].fetch_add(1);
+                taken.fetch_add(1);
+            }
+        }
+    }
+    while (auto task = deque.try_pop()) {
+        seen[*task].fetch_add(1);
+        taken.fetch_add(1);
+    }
+    while (taken.load() < tasks) {
+        std::this_thread::yield();
+    }
+    done.store(true);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    
+    EXPECT_EQ(taken.load(), tasks);
+    for (int i = 0; i < tasks; ++i) {
+        ASSERT_EQ(seen[i].load(), 1) << "task " << i;
+    }
+}